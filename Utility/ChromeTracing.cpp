@@ -9,6 +9,7 @@ namespace Tril {
 
 void ChromeTracing::AddTraceWindow(std::string name, size_t eventCount, std::chrono::steady_clock::time_point traceStart)
 {
+    std::lock_guard lock(mutex_);
     traceWindows_.push_back({ name, eventCount, traceStart });
     std::sort(std::begin(traceWindows_), std::end(traceWindows_), [](const TraceWindow& a, const TraceWindow& b) -> bool
     {
@@ -19,6 +20,7 @@ void ChromeTracing::AddTraceWindow(std::string name, size_t eventCount, std::chr
 void ChromeTracing::AddEvent(ChromeTracing::Event&& event)
 {
     auto now = std::chrono::steady_clock::now();
+    std::lock_guard lock(mutex_);
     if (IsTracing()) {
         if (events_.size() >= traceWindows_.front().samplesToCollect) {
             WriteToFile(traceWindows_.front().name, false);
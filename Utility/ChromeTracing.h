@@ -7,6 +7,7 @@
 #include <map>
 #include <chrono>
 #include <string>
+#include <mutex>
 #include <experimental/source_location>
 
 // #define ENABLE_TRACE
@@ -125,6 +126,8 @@ private:
     static inline std::string traceDirectory_ = "C:/Users/Troyseph/Desktop/";
     static inline std::vector<TraceWindow> traceWindows_ = {};
     static inline std::vector<Event> events_ = {};
+    // Events can be added from any thread
+    static inline std::mutex mutex_;
 
     static std::string ToString(const std::map<std::string, std::string>& pairs);
     static bool IsTracing();
@@ -0,0 +1,64 @@
+#include "MotionBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Tril {
+
+void MotionBatch::Clear()
+{
+    xs_.clear();
+    ys_.clear();
+    sins_.clear();
+    coss_.clear();
+    speeds_.clear();
+    distances_.clear();
+    maxDistance_ = 0.0;
+}
+
+void MotionBatch::Add(const Point& location, const Heading& heading, double speed)
+{
+    xs_.push_back(location.x);
+    ys_.push_back(location.y);
+    sins_.push_back(heading.sin);
+    coss_.push_back(heading.cos);
+    speeds_.push_back(speed);
+}
+
+void MotionBatch::Step(double minSpeed, double speedRetained)
+{
+    const size_t count = xs_.size();
+    distances_.resize(count);
+
+    double* xs = xs_.data();
+    double* ys = ys_.data();
+    const double* sins = sins_.data();
+    const double* coss = coss_.data();
+    double* speeds = speeds_.data();
+    double* distances = distances_.data();
+
+    // Kept as separate simple loops, as the compiler won't vectorise a loop
+    // that combines the select with the arithmetic, or writes too many arrays
+    for (size_t i = 0; i < count; ++i) {
+        distances[i] = std::abs(speeds[i]) > minSpeed ? speeds[i] : 0.0;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        // Same as LocalOffset{ 0.0, distance }.ApplyTo(location, heading)
+        xs[i] += distances[i] * sins[i];
+        ys[i] += distances[i] * coss[i];
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        // Exactly speed * speedRetained when moving, and speed otherwise
+        speeds[i] = (speeds[i] - distances[i]) + (distances[i] * speedRetained);
+    }
+
+    double maxDistance = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        maxDistance = std::max(maxDistance, std::abs(distances[i]));
+    }
+    maxDistance_ = maxDistance;
+}
+
+} // namespace Tril
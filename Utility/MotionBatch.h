@@ -0,0 +1,50 @@
+#ifndef MOTIONBATCH_H
+#define MOTIONBATCH_H
+
+#include "Shape.h"
+#include "Transform.h"
+
+#include <vector>
+
+namespace Tril {
+
+/**
+ * @brief Moves many objects forward by a single step. Each object travels its
+ * speed along its heading, then its speed decays.
+ *
+ * The objects are stored as a structure of arrays, so that the step is a few
+ * branchless loops over contiguous values, which the compiler can vectorise.
+ * Objects are identified by the order they were added in.
+ */
+class MotionBatch {
+public:
+    void Clear();
+    void Add(const Point& location, const Heading& heading, double speed);
+
+    /**
+     * Moves every object whose speed is greater than minSpeed, then multiplies
+     * its speed by speedRetained. Slower objects are left exactly as they are.
+     */
+    void Step(double minSpeed, double speedRetained);
+
+    size_t Size() const { return xs_.size(); }
+    bool Moved(size_t index) const { return distances_[index] != 0.0; }
+    Point GetLocation(size_t index) const { return { xs_[index], ys_[index] }; }
+    double GetSpeed(size_t index) const { return speeds_[index]; }
+    // The square of the furthest distance any object travelled in the last Step
+    double GetMaxDisplacementSquare() const { return maxDistance_ * maxDistance_; }
+
+private:
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<double> sins_;
+    std::vector<double> coss_;
+    std::vector<double> speeds_;
+    // How far each object travelled in the last Step, zero if it didn't move
+    std::vector<double> distances_;
+    double maxDistance_ = 0.0;
+};
+
+} // namespace Tril
+
+#endif // MOTIONBATCH_H
@@ -10,12 +10,24 @@ NeuralNetwork::NeuralNetwork(unsigned layerCount, unsigned width, NeuralNetwork:
 }
 
 NeuralNetwork::NeuralNetwork(std::vector<NeuralNetwork::Layer>&& layers, unsigned width)
+    : NeuralNetwork(ShareLayers(std::move(layers)), width)
+{
+}
+
+NeuralNetwork::NeuralNetwork(std::vector<SharedLayer>&& layers, unsigned width)
+    : NeuralNetwork(FindIdentityLayers(layers), std::move(layers), width)
+{
+}
+
+NeuralNetwork::NeuralNetwork(std::vector<bool>&& identityLayers, std::vector<SharedLayer>&& layers, unsigned width)
     : layers_(std::move(layers))
     , width_(width)
+    , identityLayers_(std::move(identityLayers))
 {
+    assert(identityLayers_.size() == layers_.size());
     for (auto& layer : layers_) {
-        if(layer.size() != width_) {
-            assert(layer.size() == width_);
+        if(layer->size() != width_) {
+            assert(layer->size() == width_);
         }
     }
 }
@@ -27,9 +39,9 @@ json NeuralNetwork::Serialise(const std::shared_ptr<NeuralNetwork>& network)
     }
 
     json layers = json::array();
-    for (const Layer& layer : network->layers_) {
+    for (const SharedLayer& layer : network->layers_) {
         json nodes = json::array();
-        for (const Node& node : layer) {
+        for (const Node& node : *layer) {
             json inputWeights = json::array();
             for (const InputWeight& inputWeight : node) {
                 inputWeights.push_back(inputWeight);
@@ -54,8 +66,8 @@ unsigned NeuralNetwork::GetConnectionCount() const
 {
     unsigned connectionCount = 0;
     for (const auto& layer : layers_) {
-        if (layer.size() > 0) {
-            connectionCount += layer.front().size() * layer.size();
+        if (layer->size() > 0) {
+            connectionCount += layer->front().size() * layer->size();
         }
     }
     return connectionCount;
@@ -65,7 +77,17 @@ void NeuralNetwork::ForwardPropogate(std::vector<double>& toPropogate) const
 {
     // about to swap with previousNodeValues so we can return outputs at the end
     // also allows to skip propogation when no hidden layers
-    for (const auto& layer : layers_) {
+    auto identityIter = identityLayers_.cbegin();
+    for (const auto& sharedLayer : layers_) {
+        const Layer& layer = *sharedLayer;
+        if (*identityIter++ && toPropogate.size() == layer.size()) {
+            // Each node only sees its own input with a weight of 1, so skip the matrix multiplication
+            for (double& value : toPropogate) {
+                value = std::tanh(value);
+            }
+            continue;
+        }
+
         std::swap(toPropogate, previousNodeValues_);
         // We'll reuse this vector for the output of each layer
         toPropogate.assign(layer.size(), 0.0);
@@ -85,23 +107,95 @@ void NeuralNetwork::ForwardPropogate(std::vector<double>& toPropogate) const
     }
 }
 
+void NeuralNetwork::ForwardPropogate(std::vector<double>& toPropogate, NeuralNetwork::Memo& memo, double epsilon) const
+{
+    bool unchanged = memo.network_ == this && memo.lastInputs_.size() == toPropogate.size();
+    for (size_t i = 0; unchanged && i < toPropogate.size(); ++i) {
+        unchanged = std::abs(toPropogate[i] - memo.lastInputs_[i]) <= epsilon;
+    }
+
+    if (unchanged) {
+        ++memo.hits_;
+        toPropogate = memo.lastOutputs_;
+    } else {
+        ++memo.misses_;
+        memo.network_ = this;
+        memo.lastInputs_ = toPropogate;
+        ForwardPropogate(toPropogate);
+        memo.lastOutputs_ = toPropogate;
+    }
+}
+
+std::vector<bool> NeuralNetwork::GetInputsAffecting(const std::vector<bool>& outputs) const
+{
+    std::vector<bool> affecting = outputs;
+    for (auto layerIter = layers_.crbegin(); layerIter != layers_.crend(); ++layerIter) {
+        const Layer& layer = **layerIter;
+        std::vector<bool> previous(layer.empty() ? 0 : layer.front().size(), false);
+        for (size_t nodeIndex = 0; nodeIndex < layer.size() && nodeIndex < affecting.size(); ++nodeIndex) {
+            if (affecting.at(nodeIndex)) {
+                const Node& node = layer.at(nodeIndex);
+                for (size_t edgeIndex = 0; edgeIndex < node.size(); ++edgeIndex) {
+                    if (node.at(edgeIndex) != 0.0) {
+                        previous.at(edgeIndex) = true;
+                    }
+                }
+            }
+        }
+        affecting = std::move(previous);
+    }
+    return affecting;
+}
+
+std::vector<bool> NeuralNetwork::GetOutputsAffectedBy(const std::vector<bool>& inputs) const
+{
+    std::vector<bool> affected = inputs;
+    for (const auto& sharedLayer : layers_) {
+        const Layer& layer = *sharedLayer;
+        std::vector<bool> next(layer.size(), false);
+        for (size_t nodeIndex = 0; nodeIndex < layer.size(); ++nodeIndex) {
+            const Node& node = layer.at(nodeIndex);
+            for (size_t edgeIndex = 0; edgeIndex < node.size() && edgeIndex < affected.size(); ++edgeIndex) {
+                if (affected.at(edgeIndex) && node.at(edgeIndex) != 0.0) {
+                    next.at(nodeIndex) = true;
+                    break;
+                }
+            }
+        }
+        affected = std::move(next);
+    }
+    return affected;
+}
+
 std::shared_ptr<NeuralNetwork> NeuralNetwork::WithMutatedConnections() const
 {
-    std::vector<Layer> copy = CopyLayers();
+    std::vector<SharedLayer> layers = layers_;
+    std::vector<bool> identityLayers = identityLayers_;
     unsigned connectionCount = GetConnectionCount();
 
-    for (auto& layer : copy) {
-        for (auto& node : layer) {
-            for (auto& edge : node) {
+    for (size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
+        SharedLayer& layer = layers[layerIndex];
+        // Only copy the layer once we know it is going to change
+        std::shared_ptr<Layer> mutated;
+        for (size_t nodeIndex = 0; nodeIndex < layer->size(); ++nodeIndex) {
+            for (size_t edgeIndex = 0; edgeIndex < layer->at(nodeIndex).size(); ++edgeIndex) {
                 // i.e average 3 mutations per child
                 if (Random::PercentChance(300.0 / connectionCount)) {
-                    edge += Random::Gaussian(0.0, 0.4);
+                    if (!mutated) {
+                        mutated = std::make_shared<Layer>(*layer);
+                    }
+                    mutated->at(nodeIndex).at(edgeIndex) += Random::Gaussian(0.0, 0.4);
                 }
             }
         }
+        if (mutated) {
+            // Only layers that have changed need checking again
+            identityLayers[layerIndex] = IsIdentityLayer(*mutated);
+            layer = std::move(mutated);
+        }
     }
 
-    return std::make_shared<NeuralNetwork>(std::move(copy), width_);
+    return std::shared_ptr<NeuralNetwork>(new NeuralNetwork(std::move(identityLayers), std::move(layers), width_));
 }
 
 std::shared_ptr<NeuralNetwork> NeuralNetwork::WithColumnAdded(size_t index, NeuralNetwork::InitialWeights connections) const
@@ -155,28 +249,29 @@ std::shared_ptr<NeuralNetwork> NeuralNetwork::WithColumnRemoved(size_t index) co
 
 std::shared_ptr<NeuralNetwork> NeuralNetwork::WithRowAdded(size_t index, NeuralNetwork::InitialWeights connections) const
 {
-    std::vector<Layer> copy = CopyLayers();
+    std::vector<SharedLayer> layers = layers_;
+    std::vector<bool> identityLayers = identityLayers_;
 
-    index = std::min(index, copy.size());
-    auto layersIter = copy.begin();
-    std::advance(layersIter, index);
-    copy.insert(layersIter, connections == InitialWeights::PassThrough ? CreatePassThroughLayer(width_) : CreateRandomLayer(width_));
+    index = std::min(index, layers.size());
+    auto layer = std::make_shared<const Layer>(connections == InitialWeights::PassThrough ? CreatePassThroughLayer(width_) : CreateRandomLayer(width_));
+    identityLayers.insert(std::next(identityLayers.begin(), index), IsIdentityLayer(*layer));
+    layers.insert(std::next(layers.begin(), index), std::move(layer));
 
-    return std::make_shared<NeuralNetwork>(std::move(copy), width_);
+    return std::shared_ptr<NeuralNetwork>(new NeuralNetwork(std::move(identityLayers), std::move(layers), width_));
 }
 
 std::shared_ptr<NeuralNetwork> NeuralNetwork::WithRowRemoved(size_t index) const
 {
-    std::vector<Layer> copy = CopyLayers();
+    std::vector<SharedLayer> layers = layers_;
+    std::vector<bool> identityLayers = identityLayers_;
 
-    if (!copy.empty()) {
-        index = std::min(index, copy.size());
-        auto layersIter = copy.begin();
-        std::advance(layersIter, index);
-        copy.erase(layersIter);
+    if (!layers.empty()) {
+        index = std::min(index, layers.size() - 1);
+        layers.erase(std::next(layers.begin(), index));
+        identityLayers.erase(std::next(identityLayers.begin(), index));
     }
 
-    return std::make_shared<NeuralNetwork>(std::move(copy), width_);
+    return std::shared_ptr<NeuralNetwork>(new NeuralNetwork(std::move(identityLayers), std::move(layers), width_));
 }
 
 void NeuralNetwork::ForEach(const std::function<void (unsigned, unsigned, const NeuralNetwork::Node&)>& perNode) const
@@ -184,7 +279,7 @@ void NeuralNetwork::ForEach(const std::function<void (unsigned, unsigned, const
     unsigned layerIndex = 1;
     for (const auto& layer : layers_) {
         unsigned nodeIndex = 0;
-        for (const auto& node : layer) {
+        for (const auto& node : *layer) {
             perNode(nodeIndex, layerIndex, node);
             nodeIndex++;
         }
@@ -236,15 +331,50 @@ NeuralNetwork::Layer NeuralNetwork::CreatePassThroughLayer(unsigned width)
     return layer;
 }
 
-std::vector<NeuralNetwork::Layer> NeuralNetwork::CopyLayers() const
+bool NeuralNetwork::IsIdentityLayer(const NeuralNetwork::Layer& layer)
 {
-    std::vector<Layer> copy(layers_.size(), Layer{});
-    Tril::IterateBoth<Layer, Layer>(layers_, copy, [](const Layer& origLayer, Layer& copyLayer)
-    {
-        copyLayer.reserve(origLayer.size());
-        for (const Node& origNode : origLayer ) {
-            copyLayer.push_back(Node(origNode));
+    unsigned nodeColumn = 0;
+    for (const auto& node : layer) {
+        if (node.size() != layer.size()) {
+            return false;
         }
-    });
+        for (unsigned inputColumn = 0; inputColumn < node.size(); inputColumn++) {
+            double expected = inputColumn == nodeColumn ? 1.0 : 0.0;
+            if (std::abs(node[inputColumn] - expected) > IDENTITY_TOLERANCE) {
+                return false;
+            }
+        }
+        nodeColumn++;
+    }
+    return true;
+}
+
+std::vector<bool> NeuralNetwork::FindIdentityLayers(const std::vector<NeuralNetwork::SharedLayer>& layers)
+{
+    std::vector<bool> identityLayers;
+    identityLayers.reserve(layers.size());
+    for (const SharedLayer& layer : layers) {
+        identityLayers.push_back(IsIdentityLayer(*layer));
+    }
+    return identityLayers;
+}
+
+std::vector<NeuralNetwork::SharedLayer> NeuralNetwork::ShareLayers(std::vector<NeuralNetwork::Layer>&& layers)
+{
+    std::vector<SharedLayer> sharedLayers;
+    sharedLayers.reserve(layers.size());
+    for (Layer& layer : layers) {
+        sharedLayers.push_back(std::make_shared<const Layer>(std::move(layer)));
+    }
+    return sharedLayers;
+}
+
+std::vector<NeuralNetwork::Layer> NeuralNetwork::CopyLayers() const
+{
+    std::vector<Layer> copy;
+    copy.reserve(layers_.size());
+    for (const SharedLayer& layer : layers_) {
+        copy.push_back(*layer);
+    }
     return copy;
 }
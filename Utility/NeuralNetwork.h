@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 
 /**
  * A basic NeuralNetwork with no backward propogation. The sigma function
@@ -20,6 +21,26 @@ public:
     using InputWeight = double;
     using Node = std::vector<InputWeight>;
     using Layer = std::vector<Node>;
+    /*
+     * Layers are immutable once part of a network, so they can be shared
+     * between a network and the networks derived from it via the With*
+     * methods, only the layers that are actually changed are copied.
+     */
+    using SharedLayer = std::shared_ptr<const Layer>;
+
+    /**
+     * Owned by whoever is repeatedly propogating values through a network,
+     * remembers the last inputs and outputs so that re-evaluating the same
+     * inputs can be skipped. Networks are shared, so this can't live within
+     * the network itself.
+     */
+    struct Memo {
+        const NeuralNetwork* network_ = nullptr;
+        std::vector<double> lastInputs_;
+        std::vector<double> lastOutputs_;
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+    };
 
     enum class InitialWeights : bool {
         Random,
@@ -35,19 +56,46 @@ public:
      */
     NeuralNetwork(unsigned layerCount, unsigned width, InitialWeights initialWeights);
     NeuralNetwork(std::vector<Layer>&& layers, unsigned width);
+    NeuralNetwork(std::vector<SharedLayer>&& layers, unsigned width);
 
     static nlohmann::json Serialise(const std::shared_ptr<NeuralNetwork>& network);
     std::shared_ptr<NeuralNetwork> Deserialise(const nlohmann::json& network);
 
-    unsigned GetInputCount() const { return layers_.empty() ? 0 : layers_.front().size(); }
-    unsigned GetOutputCount() const { return layers_.empty() ? 0 : layers_.back().empty() ? 0 : layers_.back().size(); }
+    unsigned GetInputCount() const { return layers_.empty() ? 0 : layers_.front()->size(); }
+    unsigned GetOutputCount() const { return layers_.empty() ? 0 : layers_.back()->empty() ? 0 : layers_.back()->size(); }
     unsigned GetConnectionCount() const;
+    /**
+     * Layers that are (near) identity matrices are evaluated as a plain tanh
+     * of the previous layer's values, skipping the matrix multiplication.
+     */
+    unsigned GetElidedLayerCount() const { return std::count(std::cbegin(identityLayers_), std::cend(identityLayers_), true); }
 
     /**
      * Inputs should be between 0.0 and 1.0 inclusive. Returns the final node
      * values.
      */
     void ForwardPropogate(std::vector<double>& inputs) const;
+    /**
+     * As above, but if each input is within epsilon of the inputs last
+     * propogated with this memo, the remembered outputs are returned instead.
+     * An epsilon of 0.0 only matches identical inputs.
+     */
+    void ForwardPropogate(std::vector<double>& inputs, Memo& memo, double epsilon) const;
+
+    /**
+     * Connectivity analysis, the sigma function maps 0.0 to 0.0, so a value
+     * with no path of non-zero weights to an output can never affect it.
+     *
+     * Returns, for each input, whether there is such a path from it to any of
+     * the flagged outputs.
+     */
+    std::vector<bool> GetInputsAffecting(const std::vector<bool>& outputs) const;
+    /**
+     * Returns, for each output, whether there is a path of non-zero weights to
+     * it from any of the flagged inputs. Unflagged inputs are presumed to be
+     * 0.0, so any output not flagged is always 0.0.
+     */
+    std::vector<bool> GetOutputsAffectedBy(const std::vector<bool>& inputs) const;
 
     void ForEach(const std::function<void(unsigned, unsigned, const Node&)>& perNode) const;
     size_t GetLayerWidth() const { return width_; }
@@ -61,16 +109,27 @@ public:
 
 private:
     static const inline std::string KEY_LAYERS = "Layers";
-    static inline std::vector<double> previousNodeValues_;
+    // Weights within this distance of an identity matrix are treated as one
+    static constexpr double IDENTITY_TOLERANCE = 1e-9;
+    // Scratch space for ForwardPropogate, one per thread so networks can be evaluated in parallel
+    static inline thread_local std::vector<double> previousNodeValues_;
 
 
-    std::vector<Layer> layers_;
+    std::vector<SharedLayer> layers_;
     size_t width_;
+    // One entry per layer, true if the layer can be evaluated without its weights
+    std::vector<bool> identityLayers_;
+
+    // identityLayers must match layers, so that the entries of shared layers can be copied rather than recalculated
+    NeuralNetwork(std::vector<bool>&& identityLayers, std::vector<SharedLayer>&& layers, unsigned width);
 
     static std::vector<Layer> CreateRandomLayers(unsigned layerCount, unsigned width);
     static Layer CreateRandomLayer(unsigned width);
     static std::vector<Layer> CreatePassThroughLayers(unsigned layerCount, unsigned width);
     static Layer CreatePassThroughLayer(unsigned width);
+    static bool IsIdentityLayer(const Layer& layer);
+    static std::vector<bool> FindIdentityLayers(const std::vector<SharedLayer>& layers);
+    static std::vector<SharedLayer> ShareLayers(std::vector<Layer>&& layers);
 
     std::vector<Layer> CopyLayers() const;
 };
@@ -3,12 +3,15 @@
 #include "Random.h"
 #include "Algorithm.h"
 
+#include <algorithm>
 #include <assert.h>
 
 using namespace nlohmann;
 
 NeuralNetworkConnector::NeuralNetworkConnector(unsigned inputs, unsigned outputs)
     : weights_(inputs, std::vector<double>(outputs, 0.0))
+    , connectionCount_(0)
+    , sparse_(false)
 {
     std::vector<size_t> inputIndexes = Tril::CreateSeries<size_t>(0, inputs);
     std::vector<size_t> outputIndexes = Tril::CreateSeries<size_t>(0, outputs);
@@ -26,11 +29,16 @@ NeuralNetworkConnector::NeuralNetworkConnector(unsigned inputs, unsigned outputs
         // set the weight of an input to an output to 1 so it is a "direct passthrough" connection
         weights_.at(in).at(out) = 1.0;
     });
+
+    UpdateRepresentation();
 }
 
 NeuralNetworkConnector::NeuralNetworkConnector(std::vector<std::vector<double>>&& weights)
     : weights_(std::move(weights))
+    , connectionCount_(0)
+    , sparse_(false)
 {
+    UpdateRepresentation();
 }
 
 json NeuralNetworkConnector::Serialise(const std::shared_ptr<NeuralNetworkConnector>& connector)
@@ -61,13 +69,21 @@ std::shared_ptr<NeuralNetworkConnector> NeuralNetworkConnector::Deserialise(cons
 void NeuralNetworkConnector::PassForward(const std::vector<double>& inputValues, std::vector<double>& outputValues)
 {
     assert(inputValues.size() == weights_.size() && outputValues.size() == weights_.at(0).size());
-    Tril::IterateBoth<double, std::vector<double>>(inputValues, weights_, [&outputValues](const double& input, const std::vector<double>& inputWeights) -> void
-    {
-        Tril::IterateBoth<double, double>(inputWeights, outputValues, [&input](const double& inputWeight, double& output) -> void
-        {
-            output += input * inputWeight;
-        });
-    });
+    if (sparse_) {
+        for (const Connection& connection : sparseConnections_) {
+            outputValues[connection.output] += inputValues[connection.input] * connection.weight;
+        }
+    } else {
+        const size_t inputCount = std::min(inputValues.size(), weights_.size());
+        for (size_t input = 0; input < inputCount; ++input) {
+            const double inputValue = inputValues[input];
+            const std::vector<double>& inputWeights = weights_[input];
+            const size_t outputCount = std::min(inputWeights.size(), outputValues.size());
+            for (size_t output = 0; output < outputCount; ++output) {
+                outputValues[output] += inputValue * inputWeights[output];
+            }
+        }
+    }
 }
 
 std::shared_ptr<NeuralNetworkConnector> NeuralNetworkConnector::WithMutatedConnections() const
@@ -159,3 +175,30 @@ std::shared_ptr<NeuralNetworkConnector> NeuralNetworkConnector::WithOutputRemove
 
     return std::make_shared<NeuralNetworkConnector>(std::move(newWeights));
 }
+
+void NeuralNetworkConnector::UpdateRepresentation()
+{
+    size_t weightCount = 0;
+    connectionCount_ = 0;
+    for (const auto& inputWeights : weights_) {
+        weightCount += inputWeights.size();
+        connectionCount_ += std::count_if(std::cbegin(inputWeights), std::cend(inputWeights), [](const double& weight)
+        {
+            return weight != 0.0;
+        });
+    }
+
+    sparse_ = weightCount > 0 && connectionCount_ <= weightCount * SPARSE_DENSITY_THRESHOLD;
+
+    sparseConnections_.clear();
+    if (sparse_) {
+        sparseConnections_.reserve(connectionCount_);
+        for (unsigned input = 0; input < weights_.size(); ++input) {
+            for (unsigned output = 0; output < weights_[input].size(); ++output) {
+                if (weights_[input][output] != 0.0) {
+                    sparseConnections_.push_back({ input, output, weights_[input][output] });
+                }
+            }
+        }
+    }
+}
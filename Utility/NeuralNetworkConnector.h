@@ -11,6 +11,13 @@
 /**
  * No hidden layers, used to pass forward the output of one neural network into
  * the input of another, even if they are different widths.
+ *
+ * Connectors are mostly created as 1:1 pass through connections, so most of the
+ * weights are exactly 0.0. When few enough weights are non-zero the connector
+ * also keeps a sparse list of the non-zero connections, so that PassForward is
+ * O(connections) instead of O(inputs * outputs). As connectors are immutable,
+ * the representation is chosen once on construction, so every mutated copy
+ * picks the appropriate representation automatically.
  */
 class NeuralNetworkConnector {
 public:
@@ -37,6 +44,12 @@ public:
 
     unsigned GetInputCount() const { return weights_.size(); }
     unsigned GetOutputCount() const { return weights_.front().size(); }
+    /**
+     * The number of non-zero weights, i.e. connections that can actually pass
+     * a value from an input to an output.
+     */
+    unsigned GetConnectionCount() const { return connectionCount_; }
+    bool IsSparse() const { return sparse_; }
     const std::vector<std::vector<double>>& Inspect() const { return weights_; }
 
     std::shared_ptr<NeuralNetworkConnector> WithMutatedConnections() const;
@@ -46,7 +59,22 @@ public:
     std::shared_ptr<NeuralNetworkConnector> WithOutputRemoved(size_t index) const;
 
 private:
+    struct Connection {
+        unsigned input;
+        unsigned output;
+        double weight;
+    };
+
+    // Above this proportion of non-zero weights, the dense loop is faster
+    static constexpr double SPARSE_DENSITY_THRESHOLD = 0.5;
+
     std::vector<std::vector<double>> weights_;
+    // Only populated when sparse_ is true
+    std::vector<Connection> sparseConnections_;
+    unsigned connectionCount_;
+    bool sparse_;
+
+    void UpdateRepresentation();
 };
 
 #endif // NEURALNETWORKCONNECTOR_H
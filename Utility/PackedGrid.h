@@ -0,0 +1,305 @@
+#ifndef PACKEDGRID_H
+#define PACKEDGRID_H
+
+#include "Shape.h"
+#include "QuadTree.h"
+#include "ChromeTracing.h"
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <utility>
+
+namespace Tril {
+
+/**
+ * @brief A spatial index for items that do not move. The items are packed into
+ * a single array, sorted by the grid cell containing their location, so a
+ * search only needs to read the contiguous run of items in each cell it covers.
+ *
+ * The grid is immutable between calls to Update (or RemoveIf), items inserted
+ * before then are held back and will not be found. Items must not move while
+ * in the grid, as their cell is only calculated when the grid is packed.
+ *
+ * Like the QuadTree, each cell can optionally maintain an Aggregate of the
+ * items within it.
+ */
+template <typename T, typename Aggregate = NoAggregate>
+class PackedGrid {
+public:
+    /**
+     * The cell size is only a target, it will be increased if the items are
+     * spread so thinly that most of the cells would be empty.
+     */
+    PackedGrid(double cellSize)
+        : targetCellSize_(cellSize)
+        , cellSize_(cellSize)
+        , cellStarts_({ 0 })
+    {
+    }
+
+    void Insert(std::shared_ptr<T> item)
+    {
+        TRACE_FUNC()
+        entering_.push_back(std::move(item));
+    }
+
+    /**
+     * Packs any inserted items into the grid, so they can be found.
+     */
+    void Update()
+    {
+        TRACE_FUNC()
+        if (!entering_.empty()) {
+            Pack();
+        }
+    }
+
+    /**
+     * Removes any items matching the predicate, including any that are yet to
+     * be packed, then packs the grid if anything has changed.
+     */
+    void RemoveIf(const std::function<bool(const T& item)>& predicate)
+    {
+        TRACE_FUNC()
+        auto removeMatching = [&](std::vector<std::shared_ptr<T>>& items) -> bool
+        {
+            auto firstRemoved = std::remove_if(std::begin(items), std::end(items), [&](const std::shared_ptr<T>& item)
+            {
+                return predicate(*item);
+            });
+            bool removedAny = firstRemoved != std::end(items);
+            items.erase(firstRemoved, std::end(items));
+            return removedAny;
+        };
+
+        bool removedAny = removeMatching(items_);
+        removeMatching(entering_);
+        if (removedAny || !entering_.empty()) {
+            Pack();
+        }
+    }
+
+    void Clear()
+    {
+        TRACE_FUNC()
+        items_.clear();
+        entering_.clear();
+        Pack();
+    }
+
+    /**
+     * Includes items that have been inserted but not yet packed.
+     */
+    size_t Size() const
+    {
+        return items_.size() + entering_.size();
+    }
+
+    /**
+     * @brief Visits every packed item, in cell order.
+     */
+    template <typename Action>
+    void ForEachItem(const Action& action) const
+    {
+        TRACE_FUNC()
+        for (const auto& item : items_) {
+            action(item);
+        }
+    }
+
+    /**
+     * @brief Visits every packed item whose location is within the area. Items
+     * extend beyond their location, so the area needs to be grown by the
+     * largest item size to find every item that overlaps it.
+     *
+     * @param cellFilter While the aggregates are valid (see UpdateAggregates),
+     * cells whose aggregate fails this predicate will be skipped.
+     */
+    template <typename Action>
+    void ForEachItem(const Rect& area, const Action& action, const std::function<bool(const Aggregate& aggregate)>& cellFilter = {}) const
+    {
+        TRACE_FUNC()
+        const bool filterCells = cellFilter && aggregatesValid_;
+        ForEachCell(area, [&](size_t cell)
+        {
+            if (!filterCells || cellFilter(aggregates_[cell])) {
+                for (size_t i = cellStarts_[cell]; i < cellStarts_[cell + 1]; ++i) {
+                    action(items_[i]);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Checks if the item has been packed into the grid, by searching
+     * only the cell containing its location.
+     */
+    bool Includes(const T& item) const
+    {
+        TRACE_FUNC()
+        bool found = false;
+        const Point& location = item.GetLocation();
+        ForEachCell(Rect{ location.x, location.y, location.x, location.y }, [&](size_t cell)
+        {
+            for (size_t i = cellStarts_[cell]; i < cellStarts_[cell + 1] && !found; ++i) {
+                found = items_[i].get() == &item;
+            }
+        });
+        return found;
+    }
+
+    /**
+     * @brief UpdateAggregates Recalculates the Aggregate of every cell from the
+     * items it currently contains. Packing the grid invalidates the aggregates
+     * until this is next called. Changes to the items themselves are not
+     * tracked.
+     */
+    void UpdateAggregates()
+    {
+        TRACE_FUNC()
+        aggregates_.assign(cellStarts_.size() - 1, Aggregate{});
+        for (size_t cell = 0; cell + 1 < cellStarts_.size(); ++cell) {
+            for (size_t i = cellStarts_[cell]; i < cellStarts_[cell + 1]; ++i) {
+                aggregates_[cell].Add(std::as_const(*items_[i]));
+            }
+        }
+        aggregatesValid_ = true;
+    }
+
+    bool AggregatesValid() const
+    {
+        return aggregatesValid_;
+    }
+
+    /**
+     * @brief Equivalent to QuadTree::ForEachAggregateOrItem, cells that lie
+     * entirely within the area are passed to aggregateAction, the items of any
+     * other cell that might be within the area are passed to itemAction.
+     *
+     * The cells are bounded by the locations of their items, so items
+     * overlapping a cell's edge may extend beyond the area.
+     */
+    void ForEachAggregateOrItem(const Circle& area, const std::function<void(const Rect& cellArea, const Aggregate& aggregate)>& aggregateAction, const std::function<void(const T& item)>& itemAction) const
+    {
+        TRACE_FUNC()
+        ForEachCell(BoundingRect(area), [&](size_t cell)
+        {
+            Rect cellArea = GetCellArea(cell);
+            if (aggregatesValid_ && Contains(area, cellArea)) {
+                aggregateAction(cellArea, aggregates_[cell]);
+            } else {
+                for (size_t i = cellStarts_[cell]; i < cellStarts_[cell + 1]; ++i) {
+                    itemAction(*items_[i]);
+                }
+            }
+        });
+    }
+
+private:
+    // The largest number of cells allowed, per item, before the cells grow
+    static constexpr size_t MAX_CELLS_PER_ITEM = 4;
+    static constexpr size_t MIN_MAX_CELLS = 1024;
+
+    std::vector<std::shared_ptr<T>> items_;
+    std::vector<std::shared_ptr<T>> entering_;
+
+    const double targetCellSize_;
+    double cellSize_;
+    Point origin_ = { 0.0, 0.0 };
+    size_t columns_ = 1;
+    size_t rows_ = 0;
+    // The items of cell i are items_[cellStarts_[i]] -> items_[cellStarts_[i + 1]]
+    std::vector<size_t> cellStarts_;
+    std::vector<Aggregate> aggregates_;
+    bool aggregatesValid_ = false;
+
+    template <typename Action>
+    void ForEachCell(const Rect& area, const Action& action) const
+    {
+        if (rows_ == 0 || area.right < origin_.x || area.bottom < origin_.y || area.left > origin_.x + (columns_ * cellSize_) || area.top > origin_.y + (rows_ * cellSize_)) {
+            return;
+        }
+        size_t left = GetIndex(area.left - origin_.x);
+        size_t top = GetIndex(area.top - origin_.y);
+        size_t right = std::min(GetIndex(area.right - origin_.x), columns_ - 1);
+        size_t bottom = std::min(GetIndex(area.bottom - origin_.y), rows_ - 1);
+        for (size_t row = top; row <= bottom; ++row) {
+            for (size_t column = left; column <= right; ++column) {
+                action((row * columns_) + column);
+            }
+        }
+    }
+
+    size_t GetIndex(double offset) const
+    {
+        return static_cast<size_t>(std::max(0.0, std::floor(offset / cellSize_)));
+    }
+
+    Rect GetCellArea(size_t cell) const
+    {
+        double left = origin_.x + ((cell % columns_) * cellSize_);
+        double top = origin_.y + ((cell / columns_) * cellSize_);
+        return { left, top, left + cellSize_, top + cellSize_ };
+    }
+
+    void Pack()
+    {
+        TRACE_FUNC()
+        std::move(std::begin(entering_), std::end(entering_), std::back_inserter(items_));
+        entering_.clear();
+        aggregatesValid_ = false;
+
+        if (items_.empty()) {
+            columns_ = 1;
+            rows_ = 0;
+            cellStarts_.assign(1, 0);
+            return;
+        }
+
+        Rect bounds = { items_.front()->GetLocation().x, items_.front()->GetLocation().y, items_.front()->GetLocation().x, items_.front()->GetLocation().y };
+        for (const auto& item : items_) {
+            const Point& location = item->GetLocation();
+            bounds.left = std::min(bounds.left, location.x);
+            bounds.top = std::min(bounds.top, location.y);
+            bounds.right = std::max(bounds.right, location.x);
+            bounds.bottom = std::max(bounds.bottom, location.y);
+        }
+
+        origin_ = { bounds.left, bounds.top };
+        cellSize_ = targetCellSize_;
+        const size_t maxCells = std::max(items_.size() * MAX_CELLS_PER_ITEM, MIN_MAX_CELLS);
+        do {
+            columns_ = GetIndex(bounds.right - bounds.left) + 1;
+            rows_ = GetIndex(bounds.bottom - bounds.top) + 1;
+            cellSize_ *= 2.0;
+        } while (columns_ * rows_ > maxCells);
+        cellSize_ /= 2.0;
+
+        // Counting sort, so the items in each cell are contiguous
+        std::vector<size_t> itemCells;
+        itemCells.reserve(items_.size());
+        cellStarts_.assign((columns_ * rows_) + 1, 0);
+        for (const auto& item : items_) {
+            const Point& location = item->GetLocation();
+            size_t cell = (GetIndex(location.y - origin_.y) * columns_) + GetIndex(location.x - origin_.x);
+            itemCells.push_back(cell);
+            ++cellStarts_[cell + 1];
+        }
+        std::partial_sum(std::begin(cellStarts_), std::end(cellStarts_), std::begin(cellStarts_));
+
+        std::vector<std::shared_ptr<T>> sorted(items_.size());
+        std::vector<size_t> next(std::begin(cellStarts_), std::end(cellStarts_) - 1);
+        for (size_t i = 0; i < items_.size(); ++i) {
+            sorted[next[itemCells[i]]++] = std::move(items_[i]);
+        }
+        items_ = std::move(sorted);
+    }
+};
+
+} // namespace Tril
+
+#endif // PACKEDGRID_H
@@ -9,6 +9,7 @@
 #include <functional>
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace Tril {
 
@@ -163,7 +164,21 @@ public:
     std::function<bool(const T& item)> itemFilter_;
 };
 
-template <typename T>
+/**
+ * @brief The default Aggregate for a QuadTree, for when no per quad summary of
+ * the items is required.
+ */
+struct NoAggregate {
+    template <typename U>
+    void Add(const U&) {}
+};
+
+/**
+ * Each quad can optionally maintain an Aggregate of all of the items within it
+ * (and within its children). An Aggregate must be default constructable (empty),
+ * and provide Add(const T& item) and Add(const Aggregate& other).
+ */
+template <typename T, typename Aggregate = NoAggregate>
 class QuadTree {
 public:
     QuadTree(const Rect& startArea, size_t itemCountTarget, size_t itemCountLeeway, double minQuadDiameter)
@@ -173,6 +188,7 @@ public:
         , itemCountLeeway_(std::min(itemCountTarget, itemCountLeeway))
         , minQuadDiameter_(minQuadDiameter)
         , currentlyIterating_(false)
+        , aggregatesValid_(false)
     {
         TRACE_FUNC()
     }
@@ -180,8 +196,28 @@ public:
     void Insert(std::shared_ptr<T> item)
     {
         TRACE_FUNC()
+        // Items inserted while iterating aren't visible until iteration ends
+        aggregatesValid_ = aggregatesValid_ && currentlyIterating_;
         AddItem(*root_, item, false);
     }
+    /**
+     * Equivalent to inserting each of the items in turn, but only rebalances
+     * the tree once.
+     */
+    void Insert(std::vector<std::shared_ptr<T>> items)
+    {
+        TRACE_FUNC()
+        if (items.empty()) {
+            return;
+        }
+        aggregatesValid_ = aggregatesValid_ && currentlyIterating_;
+        for (auto& item : items) {
+            AddItem(*root_, std::move(item), true);
+        }
+        if (!currentlyIterating_) {
+            Rebalance();
+        }
+    }
     void Clear()
     {
         TRACE_FUNC()
@@ -189,11 +225,13 @@ public:
         root_->children_ = std::nullopt;
         root_->items_.clear();
         root_->entering_.clear();
+        aggregatesValid_ = false;
     }
     void RemoveIf(const std::function<bool(const T& item)>& predicate)
     {
         TRACE_FUNC()
         assert(!currentlyIterating_);
+        aggregatesValid_ = false;
         bool requiresRebalance_ = false;
         ForEachQuad(*root_, [&](Quad& quad)
         {
@@ -228,8 +266,11 @@ public:
      * unspecified order.
      * @param quadFilter Each quad is tested based on this predicate, failed
      * quads will be skipped, as will their children.
+     * @param aggregateFilter While the aggregates are valid (see
+     * UpdateAggregates), quads whose aggregate fails this predicate will be
+     * skipped, as will their children.
      */
-    void ForEachItem(const ConstQuadTreeIterator<T>& iter) const
+    void ForEachItem(const ConstQuadTreeIterator<T>& iter, const std::function<bool(const Aggregate& aggregate)>& aggregateFilter = {}) const
     {
         TRACE_FUNC()
         ForEachQuad(*root_, [&](const Quad& quad)
@@ -239,7 +280,7 @@ public:
                     iter.itemAction_(*item);
                 }
             }
-        }, iter.quadFilter_);
+        }, iter.quadFilter_, aggregateFilter);
     }
 
     /**
@@ -257,7 +298,7 @@ public:
      * WARNING when using this function you MUST NOT change the result of
      * GetLocation() for any of the items, or the tree will stop working
      */
-    void ForEachItemNoRebalance(const QuadTreeIterator<T>& iter) const
+    void ForEachItemNoRebalance(const QuadTreeIterator<T>& iter, const std::function<bool(const Aggregate& aggregate)>& aggregateFilter = {}) const
     {
         TRACE_FUNC()
         ForEachQuad(*root_, [&](const Quad& quad)
@@ -267,7 +308,7 @@ public:
                     iter.itemAction_(item);
                 }
             }
-        }, iter.quadFilter_);
+        }, iter.quadFilter_, aggregateFilter);
     }
 
     /**
@@ -284,8 +325,11 @@ public:
      * select which items to apply the action to, and a removeItemPredicate,
      * which is equivalent to calling RemoveIf with the same predicate, but
      * wrapped up in a single pass.
+     * @param aggregateFilter While the aggregates are valid (see
+     * UpdateAggregates), quads whose aggregate fails this predicate will be
+     * skipped, as will their children.
      */
-    void ForEachItem(const QuadTreeIterator<T>& iter)
+    void ForEachItem(const QuadTreeIterator<T>& iter, const std::function<bool(const Aggregate& aggregate)>& aggregateFilter = {})
     {
         TRACE_FUNC()
         bool wasIteratingAlready = currentlyIterating_;
@@ -298,35 +342,153 @@ public:
                     iter.itemAction_(item);
                 }
             }
-        }, iter.quadFilter_);
+        }, iter.quadFilter_, aggregateFilter);
 
 
         // Let the very first non-const iteration deal with all of the re-balancing
         if (!wasIteratingAlready) {
             currentlyIterating_ = false;
+            Update(iter.removeItemPredicate_);
+        }
+    }
 
-            ForEachQuad(*root_, [&](Quad& quad)
+    /**
+     * @brief Update Moves any items whose location has changed into the correct
+     * quad, and removes any items matching the predicate, then rebalances the
+     * tree. This is the same clean up that ForEachItem performs, for when the
+     * items have been changed without iterating over the tree, e.g. via
+     * ForEachItemNoRebalance.
+     */
+    void Update(const std::function<bool(const T& item)>& removeItemPredicate)
+    {
+        TRACE_FUNC()
+        assert(!currentlyIterating_);
+        ForEachQuad(*root_, [&](Quad& quad)
+        {
+            quad.items_.erase(std::remove_if(std::begin(quad.items_), std::end(quad.items_), [&](const auto& item) -> bool
             {
-                quad.items_.erase(std::remove_if(std::begin(quad.items_), std::end(quad.items_), [&](const auto& item) -> bool
-                {
-                    bool removeFromTree = iter.removeItemPredicate_(*item);
-                    bool removeFromQuad = !Contains(quad.rect_, item->GetLocation());
+                bool removeFromTree = removeItemPredicate(*item);
+                bool removeFromQuad = !Contains(quad.rect_, item->GetLocation());
 
-                    if (!removeFromTree && removeFromQuad) {
-                        AddItem(quad, item, true);
-                    }
+                if (!removeFromTree && removeFromQuad) {
+                    AddItem(quad, item, true);
+                }
+
+                return removeFromTree || removeFromQuad;
+            }), std::end(quad.items_));
 
-                    return removeFromTree || removeFromQuad;
-                }), std::end(quad.items_));
+            std::move(std::begin(quad.entering_), std::end(quad.entering_), std::back_inserter(quad.items_));
+            quad.entering_.clear();
+        });
 
-                std::move(std::begin(quad.entering_), std::end(quad.entering_), std::back_inserter(quad.items_));
-                quad.entering_.clear();
-            });
+        Rebalance();
+    }
 
-            Rebalance();
+    /**
+     * @brief UpdateAggregates Recalculates the Aggregate of every quad from the
+     * items it currently contains. Any change to the shape of the tree (i.e.
+     * a rebalance) invalidates the aggregates until this is next called,
+     * however changes to the items themselves are not tracked, so the
+     * aggregates are only a snapshot of the items at the time of calling.
+     */
+    void UpdateAggregates()
+    {
+        TRACE_FUNC()
+        assert(!currentlyIterating_);
+
+        std::function<void(Quad& quad)> recursiveUpdate = [&](Quad& quad)
+        {
+            quad.aggregate_ = {};
+            if (quad.children_.has_value()) {
+                for (auto& child : quad.children_.value()) {
+                    recursiveUpdate(*child);
+                    quad.aggregate_.Add(std::as_const(child->aggregate_));
+                }
+            } else {
+                for (const auto& item : quad.items_) {
+                    quad.aggregate_.Add(std::as_const(*item));
+                }
+            }
+        };
+
+        recursiveUpdate(*root_);
+        aggregatesValid_ = true;
+    }
+
+    /**
+     * @brief ForEachAggregateOrItem Visits the contents of every quad that
+     * collides with the area's bounding rect. Quads that lie entirely within the area are
+     * passed to aggregateAction along with the quad's area, so all of their
+     * items can be accounted for at once. The items of all other colliding
+     * quads are passed individually to itemAction, which should do its own
+     * filtering as these items may not be within the area.
+     *
+     * If the aggregates are not valid (see UpdateAggregates) every item is
+     * passed to itemAction.
+     */
+    void ForEachAggregateOrItem(const Circle& area, const std::function<void(const Rect& quadArea, const Aggregate& aggregate)>& aggregateAction, const std::function<void(const T& item)>& itemAction) const
+    {
+        TRACE_FUNC()
+        const Rect bounds = BoundingRect(area);
+        std::function<void(const Quad& quad)> recursiveVisit = [&](const Quad& quad)
+        {
+            if (aggregatesValid_ && Contains(area, quad.rect_)) {
+                aggregateAction(quad.rect_, quad.aggregate_);
+            } else if (quad.children_.has_value()) {
+                for (const auto& child : quad.children_.value()) {
+                    if (Collides(bounds, child->rect_)) {
+                        recursiveVisit(*child);
+                    }
+                }
+            } else {
+                for (const auto& item : quad.items_) {
+                    itemAction(*item);
+                }
+            }
+        };
+
+        if (Collides(bounds, root_->rect_)) {
+            recursiveVisit(*root_);
         }
     }
 
+    /**
+     * @brief ForEachTile Splits the tree into tiles, one for each quad depth
+     * levels below the root, or for each leaf quad above that depth. Each tile
+     * is passed to tileAction, followed by every item within it. Tiles are
+     * visited in a fixed order, and between them contain every item exactly
+     * once. As items only change tile when the tree is updated, the tiles can
+     * be used to split the items between threads.
+     */
+    void ForEachTile(size_t depth, const std::function<void(const Rect& tileArea)>& tileAction, const std::function<void(const std::shared_ptr<T>& item)>& itemAction) const
+    {
+        TRACE_FUNC()
+        std::function<void(const Quad& quad, size_t depth)> recursiveVisit = [&](const Quad& quad, size_t depth)
+        {
+            if (depth > 0 && quad.children_.has_value()) {
+                for (const auto& child : quad.children_.value()) {
+                    recursiveVisit(*child, depth - 1);
+                }
+            } else {
+                tileAction(quad.rect_);
+                ForEachQuad(quad, [&](const Quad& quad)
+                {
+                    for (const auto& item : quad.items_) {
+                        itemAction(item);
+                    }
+                });
+            }
+        };
+
+        recursiveVisit(*root_, depth);
+    }
+
+    bool AggregatesValid() const
+    {
+        TRACE_FUNC()
+        return aggregatesValid_;
+    }
+
     void SetItemCountTaregt(unsigned target)
     {
         TRACE_FUNC()
@@ -435,6 +597,7 @@ private:
         Rect rect_;
         std::vector<std::shared_ptr<T>> items_;
         std::vector<std::shared_ptr<T>> entering_;
+        Aggregate aggregate_;
 
         Quad(Quad* parent, Rect rect)
             : parent_(parent)
@@ -442,6 +605,7 @@ private:
             , rect_(rect)
             , items_{}
             , entering_{}
+            , aggregate_{}
         {
         }
     };
@@ -452,6 +616,7 @@ private:
     size_t itemCountLeeway_;
     double minQuadDiameter_;
     bool currentlyIterating_;
+    bool aggregatesValid_;
 
     void ForEachQuad(Quad& quad, const std::function<void(Quad& quad)>& action)
     {
@@ -488,6 +653,23 @@ private:
         }
     }
 
+    void ForEachQuad(const Quad& quad, const std::function<void(const Quad& quad)>& action, const std::function<bool(const Rect&)>& filter, const std::function<bool(const Aggregate&)>& aggregateFilter) const
+    {
+        TRACE_FUNC()
+        if (!aggregateFilter || !aggregatesValid_) {
+            ForEachQuad(quad, action, filter);
+        } else if (aggregateFilter(quad.aggregate_)) {
+            action(quad);
+            if (quad.children_.has_value()) {
+                for (const auto& child : quad.children_.value()) {
+                    if (filter(child->rect_)) {
+                        ForEachQuad(*child, action, filter, aggregateFilter);
+                    }
+                }
+            }
+        }
+    }
+
     void AddItem(Quad& startOfSearch, std::shared_ptr<T> item, bool preventRebalance)
     {
         TRACE_FUNC()
@@ -522,6 +704,7 @@ private:
     {
         TRACE_FUNC()
         assert(!currentlyIterating_);
+        aggregatesValid_ = false;
 
         std::function<void(Quad& quad)> recursiveRebalance = [&](Quad& quad)
         {
@@ -593,6 +776,7 @@ private:
     void ExpandRoot()
     {
         TRACE_FUNC()
+        aggregatesValid_ = false;
         bool expandOutwards = rootExpandedCount_++ % 2 == 0;
         const Rect& oldRootRect = root_->rect_;
         double width = oldRootRect.right - oldRootRect.left;
@@ -8,7 +8,29 @@
 #include <limits>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <optional>
 
+namespace RandomDetail {
+
+// Declared outside of Random, as a static member can't use the default member initialisers of its own enclosing class
+struct Entropy {
+    std::mt19937 engine;
+    // The Random::seedGeneration_ engine was last seeded for
+    uint64_t seedGeneration = std::numeric_limits<uint64_t>::max();
+};
+
+} // namespace RandomDetail
+
+/**
+ * Each thread draws from its own generator, so Random can be used from any
+ * number of threads at once. Every thread's generator is seeded with the seed
+ * passed to Seed, each the next time that thread uses Random. Until Seed is
+ * called, the seed is that of a default constructed std::mt19937.
+ *
+ * Which thread runs a piece of work may change from run to run, so work that
+ * can run on any thread should draw from a Stream instead, see Stream.
+ */
 class Random {
 public:
     template<typename T>
@@ -33,9 +55,59 @@ public:
         std::discrete_distribution<size_t> distribution_;
     };
 
+    /**
+     * While a Stream exists, Random draws on the thread that created it come
+     * from the Stream, which is seeded from the seed passed to Seed and the
+     * keys it was created with. Work keyed the same way draws the same numbers,
+     * no matter which thread runs it, e.g. a Stream keyed on the tick and the
+     * entity being ticked. Streams nest, the newest being drawn from.
+     */
+    class Stream {
+    public:
+        template <typename... Keys>
+        explicit Stream(const Keys&... keys)
+            : seed_(baseSeed_.load(std::memory_order_relaxed))
+            , previous_(currentStream_)
+        {
+            ((seed_ = Mix(seed_ ^ static_cast<uint64_t>(keys))), ...);
+            currentStream_ = this;
+        }
+        Stream(const Stream& other) = delete;
+        Stream& operator=(const Stream& other) = delete;
+        ~Stream()
+        {
+            currentStream_ = previous_;
+        }
+
+    private:
+        friend Random;
+
+        // Most streams are never drawn from, so are only seeded when first used
+        std::optional<std::mt19937> engine_;
+        uint64_t seed_;
+        Stream* previous_;
+
+        std::mt19937& GetEngine()
+        {
+            if (!engine_) {
+                engine_.emplace(static_cast<std::mt19937::result_type>(seed_ ^ (seed_ >> 32)));
+            }
+            return *engine_;
+        }
+
+        // SplitMix64's finaliser, so that similar keys give unrelated seeds
+        static uint64_t Mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+    };
+
     static void Seed(const std::mt19937::result_type& seed)
     {
-        entropy_.seed(seed);
+        baseSeed_ = seed;
+        ++seedGeneration_;
     }
 
     static double Bearing()
@@ -203,7 +275,7 @@ public:
     template<typename Container>
     static void Shuffle(Container& toShuffle)
     {
-        std::shuffle(std::begin(toShuffle), std::end(toShuffle), entropy_);
+        std::shuffle(std::begin(toShuffle), std::end(toShuffle), GetEngine());
     }
 
     template<typename Container>
@@ -234,12 +306,29 @@ public:
     }
 
 private:
-    inline static std::mt19937 entropy_ = std::mt19937();
+    inline static std::atomic<std::mt19937::result_type> baseSeed_ = std::mt19937::default_seed;
+    inline static std::atomic<uint64_t> seedGeneration_ = 0;
+    inline static thread_local RandomDetail::Entropy entropy_;
+    inline static thread_local Stream* currentStream_ = nullptr;
+
+    static std::mt19937& GetEngine()
+    {
+        if (currentStream_) {
+            return currentStream_->GetEngine();
+        }
+        RandomDetail::Entropy& entropy = entropy_;
+        uint64_t generation = seedGeneration_.load(std::memory_order_acquire);
+        if (entropy.seedGeneration != generation) {
+            entropy.engine.seed(baseSeed_.load(std::memory_order_relaxed));
+            entropy.seedGeneration = generation;
+        }
+        return entropy.engine;
+    }
 
     template<typename DistributionType>
     static typename DistributionType::result_type Generate(DistributionType& distribution)
     {
-        return distribution(entropy_);
+        return distribution(GetEngine());
     }
 };
 
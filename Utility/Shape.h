@@ -193,6 +193,16 @@ inline bool Contains(const Circle& c, const Line& l)
     return Contains(c, l.a) && Contains(c, l.b);
 }
 
+inline bool Contains(const Circle& container, const Circle& containee)
+{
+    return GetDistance({ container.x, container.y }, { containee.x, containee.y }) + containee.radius <= container.radius;
+}
+
+inline bool Contains(const Circle& c, const Rect& r)
+{
+    return Contains(c, Point{ r.left, r.top }) && Contains(c, Point{ r.right, r.top }) && Contains(c, Point{ r.left, r.bottom }) && Contains(c, Point{ r.right, r.bottom });
+}
+
 inline bool Contains(const Rect& r, const Point& p)
 {
     return p.x >= r.left && p.x < r.right && p.y >= r.top && p.y < r.bottom;
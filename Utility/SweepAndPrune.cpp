@@ -0,0 +1,67 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Tril {
+
+void SweepAndPrune::Clear()
+{
+    xs_.clear();
+    ys_.clear();
+    radii_.clear();
+    offsets_.assign(1, 0);
+    overlapping_.clear();
+}
+
+void SweepAndPrune::Add(const Circle& circle)
+{
+    xs_.push_back(circle.x);
+    ys_.push_back(circle.y);
+    radii_.push_back(circle.radius);
+}
+
+void SweepAndPrune::Update()
+{
+    const uint32_t count = static_cast<uint32_t>(xs_.size());
+
+    order_.resize(count);
+    std::iota(std::begin(order_), std::end(order_), 0u);
+    std::sort(std::begin(order_), std::end(order_), [&](uint32_t a, uint32_t b)
+    {
+        return xs_[a] - radii_[a] < xs_[b] - radii_[b];
+    });
+
+    pairs_.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t a = order_[i];
+        const double right = xs_[a] + radii_[a];
+        for (uint32_t j = i + 1; j < count; ++j) {
+            const uint32_t b = order_[j];
+            if (xs_[b] - radii_[b] > right) {
+                // Every remaining circle starts even further to the right
+                break;
+            }
+            if (Collides(Circle{ xs_[a], ys_[a], radii_[a] }, Circle{ xs_[b], ys_[b], radii_[b] })) {
+                pairs_.emplace_back(a, b);
+            }
+        }
+    }
+
+    // Store each pair in both directions, grouped by the first circle
+    offsets_.assign(count + 1, 0);
+    for (const auto& [ a, b ] : pairs_) {
+        ++offsets_[a + 1];
+        ++offsets_[b + 1];
+    }
+    std::partial_sum(std::begin(offsets_), std::end(offsets_), std::begin(offsets_));
+
+    overlapping_.resize(pairs_.size() * 2);
+    std::vector<uint32_t> next(std::begin(offsets_), std::end(offsets_) - 1);
+    for (const auto& [ a, b ] : pairs_) {
+        overlapping_[next[a]++] = b;
+        overlapping_[next[b]++] = a;
+    }
+}
+
+} // namespace Tril
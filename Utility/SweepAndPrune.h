@@ -0,0 +1,56 @@
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include "Shape.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace Tril {
+
+/**
+ * @brief Finds every pair of overlapping circles in a single pass, by sorting
+ * the circles along the x axis and only testing the circles whose x extents
+ * overlap.
+ *
+ * Circles are identified by the order they were added in. Once all of the
+ * circles have been added, call Update before querying the overlaps.
+ */
+class SweepAndPrune {
+public:
+    void Clear();
+    void Add(const Circle& circle);
+    void Update();
+
+    size_t Size() const { return xs_.size(); }
+    size_t PairCount() const { return overlapping_.size() / 2; }
+
+    /**
+     * Calls action with the index of each circle that overlaps the circle at
+     * the specified index, using the same test as Collides(Circle, Circle).
+     */
+    template <typename Action>
+    void ForEachOverlapping(size_t index, const Action& action) const
+    {
+        for (uint32_t i = offsets_.at(index); i < offsets_.at(index + 1); ++i) {
+            action(overlapping_[i]);
+        }
+    }
+
+private:
+    // Circles stored as a structure of arrays so the sweep only touches what it needs
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<double> radii_;
+
+    std::vector<uint32_t> order_;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs_;
+    // The overlapping circles of circle i are overlapping_[offsets_[i]] -> overlapping_[offsets_[i + 1]]
+    std::vector<uint32_t> offsets_ = { 0 };
+    std::vector<uint32_t> overlapping_;
+};
+
+} // namespace Tril
+
+#endif // SWEEPANDPRUNE_H
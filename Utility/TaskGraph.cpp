@@ -0,0 +1,61 @@
+#include "TaskGraph.h"
+
+#include "ChromeTracing.h"
+
+#include <assert.h>
+
+namespace Tril {
+
+TaskGraph::TaskId TaskGraph::Add(std::string name, std::function<void()> task, const std::vector<TaskId>& dependencies)
+{
+    const TaskId id = tasks_.size();
+    for (TaskId dependency : dependencies) {
+        assert(dependency < id);
+        tasks_[dependency].dependents.push_back(id);
+    }
+    tasks_.push_back({ std::move(name), std::move(task), {}, dependencies.size(), {} });
+    remainingDependencies_.reset();
+    return id;
+}
+
+void TaskGraph::Run(ThreadPool& pool)
+{
+    TRACE_FUNC()
+    if (!remainingDependencies_) {
+        remainingDependencies_ = std::make_unique<std::atomic<size_t>[]>(tasks_.size());
+    }
+    for (TaskId id = 0; id < tasks_.size(); ++id) {
+        remainingDependencies_[id] = tasks_[id].dependencyCount;
+        tasks_[id].duration = {};
+    }
+
+    TaskGroup group(pool);
+    for (TaskId id = 0; id < tasks_.size(); ++id) {
+        if (tasks_[id].dependencyCount == 0) {
+            Start(id, group);
+        }
+    }
+    group.Wait();
+}
+
+void TaskGraph::Start(TaskId id, TaskGroup& group)
+{
+    group.Run([this, id, &group]()
+    {
+        Task& task = tasks_[id];
+        auto begin = std::chrono::steady_clock::now();
+        {
+            TRACE_SCOPE(task.name)
+            task.action();
+        }
+        task.duration = std::chrono::steady_clock::now() - begin;
+
+        for (TaskId dependent : task.dependents) {
+            if (--remainingDependencies_[dependent] == 0) {
+                Start(dependent, group);
+            }
+        }
+    });
+}
+
+} // namespace Tril
@@ -0,0 +1,63 @@
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include "ThreadPool.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+namespace Tril {
+
+/**
+ * @brief A set of named tasks, each with the tasks it must wait for, that can
+ * be run together on a ThreadPool any number of times.
+ *
+ * Each task is started as soon as every task it depends on has finished, so
+ * tasks that don't depend on each other may run at the same time. How long
+ * each task took during the last run is recorded, see GetDuration.
+ */
+class TaskGraph {
+public:
+    using TaskId = size_t;
+
+    /**
+     * Tasks can only depend on tasks that were added before them, so that the
+     * graph can't contain a cycle.
+     */
+    TaskId Add(std::string name, std::function<void()> task, const std::vector<TaskId>& dependencies = {});
+
+    /**
+     * Runs every task once, returning once they have all finished. If a task
+     * throws, the tasks that depend on it aren't run, and the first exception
+     * is rethrown once every other task has finished.
+     */
+    void Run(ThreadPool& pool);
+
+    size_t Size() const { return tasks_.size(); }
+    const std::string& GetName(TaskId task) const { return tasks_[task].name; }
+    // How long the task took during the last Run, zero if it didn't finish
+    std::chrono::steady_clock::duration GetDuration(TaskId task) const { return tasks_[task].duration; }
+
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> action;
+        std::vector<TaskId> dependents;
+        size_t dependencyCount;
+        std::chrono::steady_clock::duration duration;
+    };
+
+    std::vector<Task> tasks_;
+    // For each task, how many of its dependencies are yet to finish this run
+    std::unique_ptr<std::atomic<size_t>[]> remainingDependencies_;
+
+    void Start(TaskId task, TaskGroup& group);
+};
+
+} // namespace Tril
+
+#endif // TASKGRAPH_H
@@ -0,0 +1,159 @@
+#include "ThreadPool.h"
+
+#include "ChromeTracing.h"
+
+namespace Tril {
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : pending_(0)
+    , stopping_(false)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t index = 0; index < threadCount; ++index) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t index = 1; index < threadCount; ++index) {
+        threads_.emplace_back([this, index]()
+        {
+            RunWorker(index);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    // Counted before it is queued, so that the count never drops below zero
+    ++pending_;
+    Worker& worker = *workers_[GetThreadIndex()];
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    // Workers check pending_ while holding sleepMutex_, so this ensures a
+    // worker can't miss the notification between checking and waiting
+    {
+        std::lock_guard lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+    const size_t index = GetThreadIndex();
+    std::function<void()> task;
+
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    for (size_t offset = 1; !task && offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    --pending_;
+    TRACE_SCOPE("ThreadPool::Task")
+    task();
+    return true;
+}
+
+void ThreadPool::RunWorker(size_t index)
+{
+    currentPool_ = this;
+    currentIndex_ = index;
+
+    while (true) {
+        if (RunPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex_);
+        wake_.wait(lock, [&]()
+        {
+            return stopping_ || pending_ > 0;
+        });
+        if (stopping_ && pending_ == 0) {
+            return;
+        }
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : pool_(pool)
+    , outstanding_(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    WaitForOutstanding();
+}
+
+void TaskGroup::Run(std::function<void()> task)
+{
+    ++outstanding_;
+    pool_.Push([this, task = std::move(task)]()
+    {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock(exceptionMutex_);
+            if (!exception_) {
+                exception_ = std::current_exception();
+            }
+        }
+        // The group may be destroyed as soon as this reaches zero
+        --outstanding_;
+    });
+}
+
+void TaskGroup::Wait()
+{
+    TRACE_FUNC()
+    WaitForOutstanding();
+
+    std::exception_ptr exception;
+    std::swap(exception, exception_);
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::WaitForOutstanding()
+{
+    while (outstanding_ > 0) {
+        if (!pool_.RunPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace Tril
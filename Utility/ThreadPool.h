@@ -0,0 +1,177 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+namespace Tril {
+
+/**
+ * @brief Runs tasks across a fixed number of threads, see TaskGroup for adding
+ * tasks, and ParallelFor for splitting a range of indices between threads.
+ *
+ * The thread that creates the pool counts as one of its threads, and runs
+ * tasks while it waits for them, so a pool with a single thread runs every
+ * task on the calling thread. Each thread queues the tasks it adds, and runs
+ * the newest of them first, while idle threads steal the oldest tasks from
+ * other threads' queues.
+ *
+ * The pool must only be used from the thread that created it, and from
+ * within the tasks it runs.
+ */
+class ThreadPool {
+public:
+    /**
+     * A threadCount of zero uses one thread per hardware thread. The calling
+     * thread is included in the count.
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ~ThreadPool();
+
+    size_t GetThreadCount() const { return workers_.size(); }
+    /**
+     * The index of the calling thread within this pool, in the range
+     * [0, GetThreadCount()). The thread that created the pool is always 0.
+     */
+    size_t GetThreadIndex() const { return currentPool_ == this ? currentIndex_ : 0; }
+
+    /**
+     * Calls action(chunkBegin, chunkEnd) for consecutive chunks of the range
+     * [begin, end), in parallel, returning once every chunk is done. Chunks are
+     * at least grainSize long, except for the last, and a few are made for
+     * each thread, so that threads finishing early can take on the rest.
+     */
+    template <typename Action>
+    void ParallelFor(size_t begin, size_t end, size_t grainSize, const Action& action);
+
+private:
+    friend class TaskGroup;
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static inline thread_local const ThreadPool* currentPool_ = nullptr;
+    static inline thread_local size_t currentIndex_ = 0;
+
+    // Index 0 belongs to the thread that created the pool
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    // The number of tasks waiting in any of the queues
+    std::atomic<size_t> pending_;
+    std::atomic<bool> stopping_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+
+    void Push(std::function<void()> task);
+    // returns true if a task was run
+    bool RunPendingTask();
+    void RunWorker(size_t index);
+};
+
+/**
+ * @brief A set of tasks run on a ThreadPool, that can be waited on together.
+ *
+ * Tasks may add further tasks to any group, including their own. The first
+ * exception thrown by any of the group's tasks is rethrown by Wait.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    TaskGroup(const TaskGroup& other) = delete;
+    TaskGroup& operator=(const TaskGroup& other) = delete;
+    // Waits for any remaining tasks, discarding their exceptions
+    ~TaskGroup();
+
+    void Run(std::function<void()> task);
+    /**
+     * Runs queued tasks, from this group or any other, until every task in
+     * this group is done.
+     */
+    void Wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> outstanding_;
+    std::mutex exceptionMutex_;
+    std::exception_ptr exception_;
+
+    void WaitForOutstanding();
+};
+
+/**
+ * @brief A separate T for each thread of a ThreadPool, so that tasks can keep
+ * scratch space, or accumulate results, without any synchronisation. Each is
+ * kept on its own cache line, so that threads don't contend over them.
+ */
+template <typename T>
+class PerThread {
+public:
+    explicit PerThread(const ThreadPool& pool, const T& initial = {})
+        : pool_(pool)
+        , values_(pool.GetThreadCount(), Slot{ initial })
+    {
+    }
+
+    // The calling thread's T
+    T& Local() { return values_[pool_.GetThreadIndex()].value; }
+
+    template <typename Action>
+    void ForEach(const Action& action)
+    {
+        for (Slot& slot : values_) {
+            action(slot.value);
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    const ThreadPool& pool_;
+    std::vector<Slot> values_;
+};
+
+template <typename Action>
+void ThreadPool::ParallelFor(size_t begin, size_t end, size_t grainSize, const Action& action)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    const size_t count = end - begin;
+    const size_t chunksWanted = GetThreadCount() * 4;
+    const size_t chunkSize = std::max({ grainSize, size_t{ 1 }, (count + chunksWanted - 1) / chunksWanted });
+    if (GetThreadCount() == 1 || count <= chunkSize) {
+        action(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this);
+    for (size_t chunkBegin = begin + chunkSize; chunkBegin < end;) {
+        const size_t chunkEnd = chunkBegin + std::min(chunkSize, end - chunkBegin);
+        group.Run([&action, chunkBegin, chunkEnd]()
+        {
+            action(chunkBegin, chunkEnd);
+        });
+        chunkBegin = chunkEnd;
+    }
+    action(begin, begin + chunkSize);
+    group.Wait();
+}
+
+} // namespace Tril
+
+#endif // THREADPOOL_H
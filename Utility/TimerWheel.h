@@ -0,0 +1,132 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "ChromeTracing.h"
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace Tril {
+
+/**
+ * @brief Holds items until a particular tick, without needing to visit every
+ * waiting item each tick.
+ *
+ * Items are kept in a hierarchy of wheels. The first wheel has a slot for each
+ * of the next few ticks, and each subsequent wheel has slots covering ever
+ * larger ranges of ticks. When the current tick reaches the start of a slot's
+ * range, its items are moved down into the finer grained wheels, so each item
+ * is only moved a handful of times, regardless of how far in the future it is
+ * scheduled.
+ */
+template <typename T>
+class TimerWheel {
+public:
+    TimerWheel(uint64_t now = 0)
+        : now_(now)
+        , size_(0)
+    {
+    }
+
+    /**
+     * Items scheduled for a tick that has already passed will be passed to the
+     * action during the next call to Advance.
+     */
+    void Schedule(uint64_t tick, T item)
+    {
+        TRACE_FUNC()
+        tick = std::max(tick, now_);
+        uint64_t differentBits = tick ^ now_;
+        size_t level = 0;
+        while (level + 1 < LEVELS && (differentBits >> ((level + 1) * BITS_PER_LEVEL)) != 0) {
+            ++level;
+        }
+        wheels_[level][GetSlot(tick, level)].push_back({ tick, std::move(item) });
+        ++size_;
+    }
+
+    /**
+     * @brief Passes every item scheduled for any tick up to and including the
+     * specified tick to the action, in tick order. The action may schedule more
+     * items, which will be passed to the action during this call if they are
+     * due.
+     */
+    template <typename Action>
+    void Advance(uint64_t tick, const Action& action)
+    {
+        TRACE_FUNC()
+        while (now_ <= tick) {
+            // Move the items of any coarser slot starting at this tick down into finer slots
+            size_t alignedLevels = 0;
+            while (alignedLevels + 1 < LEVELS && (now_ & ((uint64_t{ 1 } << ((alignedLevels + 1) * BITS_PER_LEVEL)) - 1)) == 0) {
+                ++alignedLevels;
+            }
+            for (size_t level = alignedLevels; level > 0; --level) {
+                std::vector<Entry> cascading;
+                std::swap(cascading, wheels_[level][GetSlot(now_, level)]);
+                size_ -= cascading.size();
+                for (auto& [ itemTick, item ] : cascading) {
+                    Schedule(itemTick, std::move(item));
+                }
+            }
+
+            std::vector<Entry> due;
+            std::swap(due, wheels_[0][GetSlot(now_, 0)]);
+            size_ -= due.size();
+            for (auto& entry : due) {
+                action(entry.second);
+            }
+
+            // Anything scheduled by the action for this tick will have been put back into the same slot
+            if (wheels_[0][GetSlot(now_, 0)].empty()) {
+                ++now_;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        TRACE_FUNC()
+        for (auto& wheel : wheels_) {
+            for (auto& slot : wheel) {
+                slot.clear();
+            }
+        }
+        size_ = 0;
+    }
+
+    uint64_t Now() const
+    {
+        return now_;
+    }
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+private:
+    static constexpr size_t BITS_PER_LEVEL = 8;
+    static constexpr size_t SLOTS = size_t{ 1 } << BITS_PER_LEVEL;
+    // Enough levels to cover every possible tick
+    static constexpr size_t LEVELS = (64 + BITS_PER_LEVEL - 1) / BITS_PER_LEVEL;
+
+    using Entry = std::pair<uint64_t, T>;
+
+    // The next tick to be processed
+    uint64_t now_;
+    size_t size_;
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> wheels_;
+
+    static size_t GetSlot(uint64_t tick, size_t level)
+    {
+        return static_cast<size_t>((tick >> (level * BITS_PER_LEVEL)) & (SLOTS - 1));
+    }
+};
+
+} // namespace Tril
+
+#endif // TIMERWHEEL_H
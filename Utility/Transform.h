@@ -7,6 +7,8 @@
 #include <nlohmann/json.hpp>
 #include <fmt/format.h>
 
+#include <cmath>
+
 /**
  * @brief Placeholder for a proper matrix based coordinate system
  */
@@ -30,6 +32,49 @@ private:
     static const inline std::string KEY_Rotation = "Rotation";
 };
 
+/**
+ * @brief The sine and cosine of a bearing, calculated once so that any number
+ * of offsets can be rotated to that bearing without further trigonometry.
+ */
+struct Heading {
+public:
+    double sin;
+    double cos;
+
+    static Heading FromBearing(double bearing)
+    {
+        return { std::sin(bearing), std::cos(bearing) };
+    }
+};
+
+/**
+ * @brief An offset from something facing a bearing of 0.0, in the same form
+ * ApplyOffset uses, so it can be rotated to any Heading with a few multiplies.
+ */
+struct LocalOffset {
+public:
+    double x;
+    double y;
+
+    static LocalOffset FromPolar(double bearing, double distance)
+    {
+        return { std::sin(bearing) * distance, std::cos(bearing) * distance };
+    }
+
+    LocalOffset operator*(double scale) const
+    {
+        return { x * scale, y * scale };
+    }
+
+    /**
+     * Equivalent to ApplyOffset(origin, heading bearing + offset bearing, offset distance)
+     */
+    Point ApplyTo(const Point& origin, const Heading& heading) const
+    {
+        return { origin.x + (x * heading.cos) + (y * heading.sin), origin.y + (y * heading.cos) - (x * heading.sin) };
+    }
+};
+
 template<>
 struct fmt::formatter<Transform> : fmt::formatter<double>
 {
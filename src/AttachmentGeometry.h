@@ -0,0 +1,31 @@
+#ifndef ATTACHMENTGEOMETRY_H
+#define ATTACHMENTGEOMETRY_H
+
+#include "Entity.h"
+
+#include <optional>
+
+/**
+ * @brief Holds the world space geometry of something attached to an Entity,
+ * such as a sense or effector, and only recalculates it when the owner's
+ * transform has changed since it was last requested.
+ */
+template <typename Geometry>
+class AttachmentGeometry {
+public:
+    template <typename Calculate>
+    const Geometry& Get(const Entity& owner, const Calculate& calculate) const
+    {
+        if (!geometry_ || revision_ != owner.GetTransformRevision()) {
+            geometry_ = calculate();
+            revision_ = owner.GetTransformRevision();
+        }
+        return *geometry_;
+    }
+
+private:
+    mutable std::optional<Geometry> geometry_;
+    mutable uint64_t revision_ = 0;
+};
+
+#endif // ATTACHMENTGEOMETRY_H
@@ -0,0 +1,73 @@
+#include "CommandBuffer.h"
+
+#include "Entity.h"
+#include "Trilobyte.h"
+
+#include <ChromeTracing.h>
+
+#include <algorithm>
+#include <iterator>
+
+void CommandBuffer::AddEntity(std::shared_ptr<Entity> entity)
+{
+    additions_.push_back({ issuer_, std::move(entity) });
+}
+
+void CommandBuffer::FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency)
+{
+    feedings_.push_back({ issuer_, &eater, &food, quantity, efficiency });
+}
+
+void CommandBuffer::Damage(Entity& victim, double damage)
+{
+    injuries_.push_back({ issuer_, &victim, damage });
+}
+
+bool CommandBuffer::Empty() const
+{
+    return additions_.empty() && feedings_.empty() && injuries_.empty();
+}
+
+template <typename Command>
+std::vector<Command> CommandBuffer::Collect(std::vector<CommandBuffer>& buffers, std::vector<Command> CommandBuffer::* commands)
+{
+    std::vector<Command> collected;
+    for (CommandBuffer& buffer : buffers) {
+        if (collected.empty()) {
+            std::swap(collected, buffer.*commands);
+        } else {
+            std::move(std::begin(buffer.*commands), std::end(buffer.*commands), std::back_inserter(collected));
+            (buffer.*commands).clear();
+        }
+    }
+    auto byIssuer = [](const Command& a, const Command& b)
+    {
+        return a.issuer < b.issuer;
+    };
+    if (std::is_sorted(std::begin(collected), std::end(collected), byIssuer)) {
+        // Typically the case, when a single buffer recorded the commands in tick order
+        return collected;
+    }
+    std::stable_sort(std::begin(collected), std::end(collected), byIssuer);
+    return collected;
+}
+
+void CommandBuffer::Apply(std::vector<CommandBuffer>& buffers, const std::function<void(std::shared_ptr<Entity>)>& addEntity)
+{
+    TRACE_FUNC()
+    for (const Feeding& feeding : Collect(buffers, &CommandBuffer::feedings_)) {
+        if (feeding.eater->Exists() && feeding.food->Exists()) {
+            feeding.eater->FeedOn(*feeding.food, feeding.quantity, feeding.efficiency);
+        }
+    }
+
+    for (const Injury& injury : Collect(buffers, &CommandBuffer::injuries_)) {
+        if (injury.victim->GetType() == EntityType::Trilobyte) {
+            static_cast<Trilobyte*>(injury.victim)->ApplyDamage(injury.damage);
+        }
+    }
+
+    for (Addition& addition : Collect(buffers, &CommandBuffer::additions_)) {
+        addEntity(std::move(addition.entity));
+    }
+}
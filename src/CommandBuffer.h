@@ -0,0 +1,73 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <Energy.h>
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+class Entity;
+
+/**
+ * @brief Records the changes an entity makes to the world while it is being
+ * ticked, i.e. adding entities, feeding on other entities and damaging them,
+ * so that they can be applied once every entity has been ticked.
+ *
+ * Each command is tagged with its issuer, a number identifying the ticking
+ * entity, so that commands recorded into any number of buffers can be applied
+ * in the same order, no matter which buffer recorded them, or in which order
+ * the issuers were ticked. Commands are applied in issuer order, then in the
+ * order they were recorded.
+ *
+ * The entities referred to must outlive the commands, i.e. they must not be
+ * removed from their container until the commands have been applied.
+ */
+class CommandBuffer {
+public:
+    void SetIssuer(uint64_t issuer) { issuer_ = issuer; }
+
+    void AddEntity(std::shared_ptr<Entity> entity);
+    void FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency);
+    void Damage(Entity& victim, double damage);
+
+    bool Empty() const;
+
+    /**
+     * Applies, then clears, the commands from every buffer. All feeding is
+     * applied first, in issuer order, so when several eaters are feeding on
+     * the same food, the first issuer eats first, and later issuers only get
+     * whatever is left, and only gain their efficiency of what they get. Eaters that no longer exist don't eat at all. Damage is
+     * applied next, then the new entities are passed to addEntity.
+     */
+    static void Apply(std::vector<CommandBuffer>& buffers, const std::function<void(std::shared_ptr<Entity> entity)>& addEntity);
+
+private:
+    struct Addition {
+        uint64_t issuer;
+        std::shared_ptr<Entity> entity;
+    };
+    struct Feeding {
+        uint64_t issuer;
+        Entity* eater;
+        Entity* food;
+        Energy quantity;
+        double efficiency;
+    };
+    struct Injury {
+        uint64_t issuer;
+        Entity* victim;
+        double damage;
+    };
+
+    uint64_t issuer_ = 0;
+    std::vector<Addition> additions_;
+    std::vector<Feeding> feedings_;
+    std::vector<Injury> injuries_;
+
+    template <typename Command>
+    static std::vector<Command> Collect(std::vector<CommandBuffer>& buffers, std::vector<Command> CommandBuffer::* commands);
+};
+
+#endif // COMMANDBUFFER_H
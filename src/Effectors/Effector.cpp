@@ -7,6 +7,7 @@ Effector::Effector(const std::shared_ptr<NeuralNetwork>& network, const std::sha
     , network_(network)
     , inputConnections_(inputConnections)
     , outputs_(inputConnections->GetOutputCount(), 0.0)
+    , constantInputs_(false)
 {
 }
 
@@ -14,8 +15,21 @@ Effector::~Effector()
 {
 }
 
+void Effector::SetInputsConstant(bool constant)
+{
+    constantInputs_ = constant;
+    if (constantInputs_) {
+        std::fill(std::begin(outputs_), std::end(outputs_), 0.0);
+        network_->ForwardPropogate(outputs_);
+    }
+}
+
 Energy Effector::Tick(const std::vector<double>& inputs, EntityContainerInterface& entities, const UniverseParameters& universeParameters)
 {
+    if (constantInputs_) {
+        return PerformActions(outputs_, entities, universeParameters);
+    }
+
     std::fill(std::begin(outputs_), std::end(outputs_), 0.0);
     inputConnections_->PassForward(inputs, outputs_);
     network_->ForwardPropogate(outputs_);
@@ -25,9 +25,21 @@ public:
     virtual std::string GetDescription() const = 0;
 
     virtual void Draw(QPainter& paint) const = 0;
+    /**
+     * The furthest distance from the owner's centre at which this effector can
+     * affect anything, used to gather the owner's Neighbourhood.
+     */
+    virtual double GetReach() const { return 0.0; }
     virtual Energy Tick(const std::vector<double>& inputs, EntityContainerInterface& entities, const UniverseParameters& universeParameters) final;
 
     unsigned GetInputCount() const { return network_->GetInputCount(); }
+    /**
+     * When none of the inputs can ever be anything but 0.0 (see
+     * Genome::GetPhenoType), the network is propogated once and its outputs are
+     * re-used every tick. Actions are still performed each tick.
+     */
+    void SetInputsConstant(bool constant);
+    bool HasConstantInputs() const { return constantInputs_; }
 
     const NeuralNetwork& Inspect() const { return *network_; }
     const NeuralNetworkConnector& InspectConnection() const { return *inputConnections_; }
@@ -39,6 +51,7 @@ private:
     std::shared_ptr<NeuralNetwork> network_;
     std::shared_ptr<NeuralNetworkConnector> inputConnections_;
     std::vector<double> outputs_;
+    bool constantInputs_;
 
     virtual Energy PerformActions(const std::vector<double>& actionValues, EntityContainerInterface& entities, const UniverseParameters& universeParameters) = 0;
 };
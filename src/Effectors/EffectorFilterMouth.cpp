@@ -26,15 +26,14 @@ Energy EffectorFilterMouth::PerformActions(const std::vector<double>& /*actionVa
     //static Tril::RangeConverter inputToMouthOpen{ { -1.0, 1.0 }, { 0.0, 1.0 } };
 
     //const double mouthOpenProportion = inputToMouthOpen.ConvertAndClamp(actionValues.at(0));
-    Energy foodEaten = 0_j;
-    entities.ForEachCollidingWith(Circle{ owner_.GetTransform().x, owner_.GetTransform().y, owner_.GetRadius() }, [&](const std::shared_ptr<Entity>& entity)
+    entities.ForEachContact(owner_, [&](const std::shared_ptr<Entity>& entity)
     {
-        if (entity->GetRadius() <= FOOD_RADIUS_THRESHOLD /*&& Random::PercentChance(mouthOpenProportion * 100.0)*/) {
-            foodEaten += entity->GetEnergy();
-            owner_.FeedOn(*entity, entity->GetEnergy());
+        const EntityTraits food = entity->GetTraits();
+        if (food.size <= FOOD_RADIUS_THRESHOLD /*&& Random::PercentChance(mouthOpenProportion * 100.0)*/) {
+            // Filter mouth is only 75% efficient, charged on what is actually eaten, which is less if another mouth eats first
+            entities.FeedOn(owner_, *entity, food.energy, 0.75);
         }
     });
 
-    // Filter mouth is only 75% efficient, so burn 25% of what was eaten
-    return foodEaten * 0.25;
+    return 0_j;
 }
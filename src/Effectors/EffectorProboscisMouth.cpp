@@ -1,7 +1,6 @@
 #include "EffectorProboscisMouth.h"
 
 #include "Trilobyte.h"
-#include "Egg.h"
 
 #include <QPainter>
 
@@ -31,35 +30,44 @@ std::string EffectorProboscisMouth::GetDescription() const
 
 void EffectorProboscisMouth::Draw(QPainter& paint) const
 {
-    Line proboscis = GetProboscis();
+    const Line& proboscis = GetProboscis();
     paint.drawLine(QLineF(QPointF(proboscis.a.x, proboscis.a.y), QPointF(proboscis.b.x, proboscis.b.y)));
 }
 
+double EffectorProboscisMouth::GetReach() const
+{
+    return owner_.GetRadius() + proboscisLength_;
+}
+
 Energy EffectorProboscisMouth::PerformActions(const std::vector<double>& /*actionValues*/, EntityContainerInterface& entities, const UniverseParameters& /*universeParameters*/)
 {
-    Line proboscis = GetProboscis();
+    const Line& proboscis = GetProboscis();
     std::shared_ptr<Entity> victim;
+    Energy victimEnergy = 0_j;
     entities.ForEachCollidingWith(proboscis.b, [&](const std::shared_ptr<Entity>& entity)
     {
-        if (dynamic_cast<Trilobyte*>(entity.get()) || dynamic_cast<Egg*>(entity.get())) {
-            if (!victim || entity->GetEnergy() > victim->GetEnergy()) {
-                victim = entity;
-            }
+        const Energy energy = entity->GetTraits().energy;
+        if (!victim || energy > victimEnergy) {
+            victim = entity;
+            victimEnergy = energy;
         }
-    });
+    }, MaskOf(EntityType::Trilobyte, EntityType::Egg));
 
     if (victim) {
-        Energy quantity = std::min(30_mj, victim->GetEnergy());
-        owner_.FeedOn(*victim, quantity);
+        Energy quantity = std::min(30_mj, victimEnergy);
+        entities.FeedOn(owner_, *victim, quantity);
         return quantity;
     } else {
         return 0_j;
     }
 }
 
-Line EffectorProboscisMouth::GetProboscis() const
+const Line& EffectorProboscisMouth::GetProboscis() const
 {
-    Point start = ApplyOffset(owner_.GetLocation(), owner_.GetTransform().rotation, owner_.GetRadius());
-    Point end = ApplyOffset(start, owner_.GetTransform().rotation, proboscisLength_);
-    return Line{ start, end };
+    return proboscis_.Get(owner_, [&]()
+    {
+        Point start = LocalOffset{ 0.0, owner_.GetRadius() }.ApplyTo(owner_.GetLocation(), owner_.GetHeading());
+        Point end = LocalOffset{ 0.0, proboscisLength_ }.ApplyTo(start, owner_.GetHeading());
+        return Line{ start, end };
+    });
 }
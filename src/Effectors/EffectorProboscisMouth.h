@@ -2,6 +2,8 @@
 #define EFFECTORPROBOSCISMOUTH_H
 
 #include "Effector.h"
+#include "AttachmentGeometry.h"
+
 #include <Shape.h>
 
 class EffectorProboscisMouth : public Effector {
@@ -12,13 +14,15 @@ public:
     virtual std::string_view GetName() const override { return "Proboscis"; }
     virtual std::string GetDescription() const override;
     virtual void Draw(QPainter& paint) const override;
+    virtual double GetReach() const override;
 
 private:
     double proboscisLength_;
+    AttachmentGeometry<Line> proboscis_;
 
     virtual Energy PerformActions(const std::vector<double>& actionValues, EntityContainerInterface& entities, const UniverseParameters& universeParameters) override;
 
-    Line GetProboscis() const;
+    const Line& GetProboscis() const;
 };
 
 #endif // EFFECTORPROBOSCISMOUTH_H
@@ -11,6 +11,9 @@ EffectorSpike::EffectorSpike(const std::shared_ptr<NeuralNetwork>& network, cons
     : Effector(network, inputConnections, owner)
     , bearing_(bearing)
     , length_(length)
+    , direction_(LocalOffset::FromPolar(bearing, 1.0))
+    , baseRightOffset_(LocalOffset::FromPolar(bearing - (Tril::Tau * 0.47), length + 2.0))
+    , baseLeftOffset_(LocalOffset::FromPolar(bearing + (Tril::Tau * 0.47), length + 2.0))
 {
 }
 
@@ -30,9 +33,9 @@ std::string EffectorSpike::GetDescription() const
 
 void EffectorSpike::Draw(QPainter& paint) const
 {
-    Point tip = GetTipOfSpike();
-    Point baseRight = ApplyOffset(tip, (bearing_ + owner_.GetTransform().rotation) - (Tril::Tau * 0.47), length_ + 2.0);
-    Point baseLeft = ApplyOffset(tip, (bearing_ + owner_.GetTransform().rotation) + (Tril::Tau * 0.47), length_ + 2.0);
+    const Point& tip = GetTipOfSpike();
+    Point baseRight = baseRightOffset_.ApplyTo(tip, owner_.GetHeading());
+    Point baseLeft = baseLeftOffset_.ApplyTo(tip, owner_.GetHeading());
 
     QPainterPath spikeTriangle;
     spikeTriangle.moveTo(tip.x, tip.y);
@@ -43,28 +46,35 @@ void EffectorSpike::Draw(QPainter& paint) const
     paint.drawPath(spikeTriangle);
 }
 
+double EffectorSpike::GetReach() const
+{
+    return owner_.GetRadius() + length_;
+}
+
 Energy EffectorSpike::PerformActions(const std::vector<double>& /*actionValues*/, EntityContainerInterface& entities, const UniverseParameters& /*universeParameters*/)
 {
     entities.ForEachCollidingWith(GetTipOfSpike(), [&](const std::shared_ptr<Entity>& entity)
     {
-        if (Trilobyte* victim = dynamic_cast<Trilobyte*>(entity.get())) {
-            Vec2 spikeVec = GetMovementVector(bearing_ + owner_.GetTransform().rotation, owner_.GetVelocity());
-            // FIXME entity rotation and direction of movement may not actually be the same! (they were when writing, but perhaps that should change!)
-            Vec2 victimVec = GetMovementVector(entity->GetTransform().rotation, entity->GetVelocity());
+        Point spikeDirection = direction_.ApplyTo({ 0.0, 0.0 }, owner_.GetHeading());
+        Vec2 spikeVec = { spikeDirection.x * owner_.GetVelocity(), spikeDirection.y * owner_.GetVelocity() };
+        // FIXME entity rotation and direction of movement may not actually be the same! (they were when writing, but perhaps that should change!)
+        Vec2 victimVec = GetMovementVector(entity->GetPublishedBearing(), entity->GetPublishedVelocity());
 
-            auto [ contactBearing, contactVelocity ] = DeconstructMovementVector({ spikeVec.x - victimVec.x, spikeVec.y - victimVec.y });
+        auto [ contactBearing, contactVelocity ] = DeconstructMovementVector({ spikeVec.x - victimVec.x, spikeVec.y - victimVec.y });
 
-            double collisionBearing = std::fmod(std::abs(bearing_ - contactBearing), Tril::Tau);
-            double directHitProportion = std::max(0.0, ((std::abs(collisionBearing - Tril::Pi) / Tril::Pi) - 0.5) * 2);
-            victim->ApplyDamage(directHitProportion * (5 * std::pow(contactVelocity, 2.0)));
-        }
-    });
+        double collisionBearing = std::fmod(std::abs(bearing_ - contactBearing), Tril::Tau);
+        double directHitProportion = std::max(0.0, ((std::abs(collisionBearing - Tril::Pi) / Tril::Pi) - 0.5) * 2);
+        entities.Damage(*entity, directHitProportion * (5 * std::pow(contactVelocity, 2.0)));
+    }, MaskOf(EntityType::Trilobyte));
 
     // Spike is entirely passive, MAYBE add ability to apply venom for a cost (either constant or neuron controllable)
     return 0_j;
 }
 
-Point EffectorSpike::GetTipOfSpike() const
+const Point& EffectorSpike::GetTipOfSpike() const
 {
-    return ApplyOffset(owner_.GetLocation(), bearing_ + owner_.GetTransform().rotation, owner_.GetRadius() + length_);
+    return tip_.Get(owner_, [&]()
+    {
+        return (direction_ * (owner_.GetRadius() + length_)).ApplyTo(owner_.GetLocation(), owner_.GetHeading());
+    });
 }
@@ -2,7 +2,10 @@
 #define EFFECTORSPIKE_H
 
 #include "Effector.h"
+#include "AttachmentGeometry.h"
+
 #include <Shape.h>
+#include <Transform.h>
 
 class EffectorSpike : public Effector {
 public:
@@ -13,14 +16,19 @@ public:
     virtual std::string GetDescription() const override;
 
     virtual void Draw(QPainter& paint) const override;
+    virtual double GetReach() const override;
 
 private:
     double bearing_;
     double length_;
+    LocalOffset direction_;
+    LocalOffset baseRightOffset_;
+    LocalOffset baseLeftOffset_;
+    AttachmentGeometry<Point> tip_;
 
     virtual Energy PerformActions(const std::vector<double>& actionValues, EntityContainerInterface& entities, const UniverseParameters& universeParameters) override;
 
-    Point GetTipOfSpike() const;
+    const Point& GetTipOfSpike() const;
 };
 
 #endif // EFFECTORSPIKE_H
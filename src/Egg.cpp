@@ -5,12 +5,12 @@
 #include <QPainter>
 
 Egg::Egg(std::shared_ptr<Trilobyte>&& mother, Energy energy, const Transform& transform, std::shared_ptr<Genome> genomeOne, std::shared_ptr<Genome> genomeTwo, unsigned hatchingDelay)
-    : Entity(transform, 3.5, QColor::fromRgb(125, 57, 195), energy, mother->GetVelocity())
+    : Entity(EntityType::Egg, transform, 3.5, QColor::fromRgb(125, 57, 195), energy, mother->GetVelocity())
     , mother_(std::move(mother))
     , genomeOne_(genomeOne)
     , genomeTwo_(genomeTwo)
-    , hatchingDelay_(hatchingDelay)
 {
+    SetWakeAge(hatchingDelay);
 }
 
 Egg::~Egg()
@@ -32,9 +32,8 @@ void Egg::TickImpl(EntityContainerInterface& container, const UniverseParameters
     // TODO add a gene to decide how much energy to pass to eggs
 
 
-    if (hatchingDelay_ > 0) {
-        hatchingDelay_--;
-    } else {
+    // Only ticked while dormant if we are still moving
+    if (!IsDormant()) {
         // cross with self for now
         std::shared_ptr<Genome> genome = Genome::CreateOffspring(*genomeOne_, *genomeTwo_, universeParameters);
         if (genome) {
@@ -51,7 +50,7 @@ std::vector<Property> Egg::CollectProperties() const
             "Delay",
             [&]() -> std::string
             {
-                return fmt::format("{}", this->hatchingDelay_);
+                return fmt::format("{}", this->IsDormant() ? this->GetWakeAge() - this->GetAge() : 0);
             },
             "The number of ticks until the egg hatches",
         },
@@ -6,7 +6,7 @@
 
 #include <NeuralNetwork.h>
 
-class Egg : public Entity {
+class Egg final : public Entity {
 public:
     Egg(std::shared_ptr<Trilobyte>&& parent, Energy energy, const Transform& transform, std::shared_ptr<Genome> genomeOne, std::shared_ptr<Genome> genomeTwo, unsigned hatchingDelay);
     virtual ~Egg() override;
@@ -15,13 +15,14 @@ public:
     virtual std::string_view GetDescription() const override;
 
 protected:
+    friend class Entity; // For TickAs
+
     virtual void TickImpl(EntityContainerInterface& container, const UniverseParameters& universeParameters) override;
 
 private:
     std::shared_ptr<Trilobyte> mother_;
     std::shared_ptr<Genome> genomeOne_;
     std::shared_ptr<Genome> genomeTwo_;
-    unsigned hatchingDelay_;
 
     virtual std::vector<Property> CollectProperties() const override;
 };
@@ -9,14 +9,27 @@
 #include <QPainter>
 
 #include <assert.h>
+#include <limits>
 
-Entity::Entity(const Transform& transform, double radius, QColor colour, Energy energy, double speed)
-    : energy_(energy)
+Entity::Entity(EntityType type, const Transform& transform, double radius, QColor colour, Energy energy, double speed)
+    : type_(type)
+    , energy_(energy)
     , transform_(transform)
+    , heading_(Heading::FromBearing(transform.rotation))
+    , transformRevision_(0)
     , radius_(radius)
     , speed_(speed)
-    , age_(0)
+    , clock_(nullptr)
+    , birthTick_(0)
+    , wakeAge_(0)
+    , energyRetainedPerTick_(1.0)
+    , minimumEnergy_(0_j)
+    , energyAge_(0)
+    , expiryAge_(std::numeric_limits<uint64_t>::max())
+    , energyToRadius_(nullptr)
     , colour_(colour)
+    , publishedBearing_(transform.rotation)
+    , publishedSpeed_(speed)
 {
     assert(radius_ <= MAX_RADIUS);
 }
@@ -40,7 +53,7 @@ std::vector<Property> Entity::GetProperties() const
             "Energy",
             [&]() -> std::string
             {
-                return fmt::format("{:.2f}mj", this->energy_ / 1_mj);
+                return fmt::format("{:.2f}mj", this->GetEnergy() / 1_mj);
             },
             "The current energy available to the entity in milli-joules."
         },
@@ -48,7 +61,7 @@ std::vector<Property> Entity::GetProperties() const
             "Exists",
             [&]() -> std::string
             {
-                return fmt::format("{}", !this->terminated_);
+                return fmt::format("{}", this->Exists());
             },
             "True if the entity is currently part of a simulation."
         },
@@ -64,7 +77,7 @@ std::vector<Property> Entity::GetProperties() const
             "Size",
             [&]() -> std::string
             {
-                return fmt::format("{:.2f}", this->radius_ * 2);
+                return fmt::format("{:.2f}", this->GetRadius() * 2);
             },
             "The width of the entity. All entities are considered to be circular."
         },
@@ -80,7 +93,7 @@ std::vector<Property> Entity::GetProperties() const
             "Age",
             [&]() -> std::string
             {
-                return fmt::format("{}", this->age_);
+                return fmt::format("{}", this->GetAge());
             },
             "The number of ticks that this entity has existed within a simulation."
         },
@@ -97,19 +110,94 @@ std::vector<Property> Entity::GetProperties() const
     return Tril::Combine(std::move(entityProperties), CollectProperties());
 }
 
-void Entity::FeedOn(Entity& other, Energy quantity)
+void Entity::FeedOn(Entity& other, Energy quantity, double efficiency)
 {
-    energy_ += other.TakeEnergy(quantity);
+    SetEnergy(GetEnergy() + (other.TakeEnergy(quantity) * efficiency));
     if (other.GetEnergy() <= 0.0) {
         other.Terminate();
     }
+    // Feeding is applied once every entity has been ticked, and the food isn't
+    // necessarily ticked itself, so both are published straight away
+    Publish();
+    other.Publish();
 }
 
 bool Entity::Tick(EntityContainerInterface& container, const UniverseParameters& universeParameters)
 {
     TickImpl(container, universeParameters);
-    age_++;
-    return Move();
+    bool moved = Move();
+    Publish();
+    return moved;
+}
+
+void Entity::Publish()
+{
+    publishedTraits_.red = colour_.redF();
+    publishedTraits_.green = colour_.greenF();
+    publishedTraits_.blue = colour_.blueF();
+    publishedTraits_.energy = GetEnergy();
+    publishedTraits_.size = GetRadius();
+    publishedTraits_.health = GetHealth();
+    publishedBearing_ = transform_.rotation;
+    publishedSpeed_ = speed_;
+}
+
+EntityTraits Entity::GetTraits() const
+{
+    EntityTraits traits = publishedTraits_;
+    traits.age = GetAge();
+    if (energyRetainedPerTick_ != 1.0) {
+        traits.energy = GetEnergy();
+        traits.size = GetRadius();
+    }
+    return traits;
+}
+
+void Entity::SetClock(const uint64_t& tick)
+{
+    uint64_t age = GetAge();
+    clock_ = &tick;
+    birthTick_ = tick - age;
+}
+
+void EntityTraitTotals::Add(const Entity& entity)
+{
+    const EntityTraits traits = entity.GetTraits();
+    ++count;
+    types |= entity.GetTypeMask();
+    sum.red += traits.red;
+    sum.green += traits.green;
+    sum.blue += traits.blue;
+    sum.energy += traits.energy;
+    sum.age += traits.age;
+    sum.size += traits.size;
+    sum.health += traits.health;
+}
+
+void EntityTraitTotals::Add(const EntityTraitTotals& other)
+{
+    count += other.count;
+    types |= other.types;
+    sum.red += other.sum.red;
+    sum.green += other.sum.green;
+    sum.blue += other.sum.blue;
+    sum.energy += other.sum.energy;
+    sum.age += other.sum.age;
+    sum.size += other.sum.size;
+    sum.health += other.sum.health;
+}
+
+void EntityTraitTotals::Remove(const Entity& entity)
+{
+    const EntityTraits traits = entity.GetTraits();
+    --count;
+    sum.red -= traits.red;
+    sum.green -= traits.green;
+    sum.blue -= traits.blue;
+    sum.energy -= traits.energy;
+    sum.age -= traits.age;
+    sum.size -= traits.size;
+    sum.health -= traits.health;
 }
 
 void Entity::Draw(QPainter& paint, const DrawSettings& options)
@@ -131,7 +219,7 @@ void Entity::Draw(QPainter& paint, const DrawSettings& options)
         pen.setCosmetic(true);
         paint.setPen(pen);
         paint.setBrush(colour_);
-        paint.drawEllipse(centre, radius_, radius_);
+        paint.drawEllipse(centre, GetRadius(), GetRadius());
     } else {
         // Rotate the painter so it looks like our pixmap has been rotated
         paint.translate(centre);
@@ -149,11 +237,37 @@ void Entity::Draw(QPainter& paint, const DrawSettings& options)
 
 Energy Entity::TakeEnergy(Energy quantity)
 {
-    Energy toGive = std::min(energy_, quantity);
-    energy_ -= quantity;
+    Energy energy = GetEnergy();
+    Energy toGive = std::min(energy, quantity);
+    SetEnergy(energy - quantity);
     return toGive;
 }
 
+void Entity::SetEnergyDecay(double retainedPerTick, Energy minimum, double (*energyToRadius)(const Energy&))
+{
+    Energy energy = GetEnergy();
+    energyRetainedPerTick_ = retainedPerTick;
+    minimumEnergy_ = minimum;
+    energyToRadius_ = energyToRadius;
+    SetEnergy(energy);
+}
+
+double Entity::GetDecayedEnergy() const
+{
+    return energy_ * std::pow(energyRetainedPerTick_, static_cast<double>(GetAge() - energyAge_));
+}
+
+void Entity::SetEnergy(Energy energy)
+{
+    energy_ = energy;
+    energyAge_ = GetAge();
+    if (energyRetainedPerTick_ < 1.0 && minimumEnergy_ > 0_j) {
+        // The number of ticks until energy * retainedPerTick^ticks < minimum
+        double ticks = energy_ >= minimumEnergy_ ? std::floor(std::log(minimumEnergy_ / energy_) / std::log(energyRetainedPerTick_)) + 1.0 : 0.0;
+        expiryAge_ = energyAge_ + static_cast<uint64_t>(std::max(0.0, ticks));
+    }
+}
+
 void Entity::SetBearing(double bearing)
 {
     if (bearing < 0.0) {
@@ -162,15 +276,18 @@ void Entity::SetBearing(double bearing)
         bearing -= Tril::Tau;
     }
     transform_.rotation = bearing;
+    heading_ = Heading::FromBearing(bearing);
+    ++transformRevision_;
 }
 
 bool Entity::Move()
 {
-    if (std::abs(speed_) > 0.05) {
-        Point newLocation = ApplyOffset({ transform_.x, transform_.y }, transform_.rotation, speed_);
+    if (!IsAtRest()) {
+        Point newLocation = LocalOffset{ 0.0, speed_ }.ApplyTo({ transform_.x, transform_.y }, heading_);
         transform_.x = newLocation.x;
         transform_.y = newLocation.y;
-        speed_ *= 0.9;
+        ++transformRevision_;
+        speed_ *= SPEED_RETAINED_PER_TICK;
         return true;
     }
     return false;
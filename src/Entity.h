@@ -4,6 +4,7 @@
 #include "EntityContainerInterface.h"
 #include "UniverseParameters.h"
 #include "DrawSettings.h"
+#include "EntityTraits.h"
 
 #include <Shape.h>
 #include <Energy.h>
@@ -16,6 +17,8 @@
 
 #include <string_view>
 #include <array>
+#include <cmath>
+#include <type_traits>
 
 class QPainter;
 
@@ -30,8 +33,12 @@ class QPainter;
 class Entity {
 public:
     static constexpr double MAX_RADIUS = 12.0;
+    // Entities moving slower than this don't move at all
+    static constexpr double MIN_SPEED = 0.05;
+    // The fraction of an entity's speed that remains after each tick it moves
+    static constexpr double SPEED_RETAINED_PER_TICK = 0.9;
 
-    Entity(const Transform& transform, double radius, QColor colour, Energy energy = 0_j, double speed = 0.0);
+    Entity(EntityType type, const Transform& transform, double radius, QColor colour, Energy energy = 0_j, double speed = 0.0);
     virtual ~Entity();
 
     virtual std::string_view GetName() const = 0;
@@ -39,50 +46,146 @@ public:
 
     std::vector<Property> GetProperties() const;
 
-    const uint64_t& GetAge() const { return age_; }
+    EntityType GetType() const { return type_; }
+    EntityTypeMask GetTypeMask() const { return MaskOf(type_); }
+    uint64_t GetAge() const { return clock_ ? *clock_ - birthTick_ : 0; }
     const Transform& GetTransform() const { return transform_; }
-    static inline Point p{}; // FIXME hack to remove static func variable (for performance reasons, thread safe access each call...)
-    const Point& GetLocation() const { p = { transform_.x, transform_.y }; return p; }
-    const double& GetRadius() const { return radius_; }
-    double GetEnergy() const { return energy_; }
+    const Heading& GetHeading() const { return heading_; }
+    /**
+     * Changes whenever the transform or radius changes, so that anything
+     * attached to this entity can cache its world space geometry.
+     */
+    const uint64_t& GetTransformRevision() const { return transformRevision_; }
+    Point GetLocation() const { return { transform_.x, transform_.y }; }
+    double GetRadius() const { return energyToRadius_ ? energyToRadius_(GetEnergy()) : radius_; }
+    double GetEnergy() const { return energyRetainedPerTick_ == 1.0 ? energy_ : GetDecayedEnergy(); }
     const QColor& GetColour() const { return colour_; }
     const double& GetVelocity() const { return speed_; }
-    bool Exists() const { return !terminated_; }
-    static inline Circle c{}; // FIXME hack to remove static func variable (for performance reasons, thread safe access each call...)
-    const Circle& GetCollide() const { c = { transform_.x, transform_.y, radius_ }; return c; };
-
-    void SetLocation(const Point& location) { transform_.x = location.x; transform_.y = location.y; }
-    void FeedOn(Entity& other, Energy quantity);
+    bool Exists() const { return !terminated_ && GetAge() < expiryAge_; }
+    bool IsAtRest() const { return std::abs(speed_) <= MIN_SPEED; }
+    /**
+     * Entities that can start moving by themselves are never put to sleep,
+     * every other entity is considered static while it is at rest.
+     */
+    virtual bool IsSelfPropelled() const { return false; }
+    Circle GetCollide() const { return { transform_.x, transform_.y, GetRadius() }; }
+    virtual double GetHealth() const { return 0.0; }
+    /**
+     * What other entities see of this entity, as it was when last published.
+     * Containers publish every entity once all of them have been ticked, so
+     * while entities are being ticked each sees the others as they were at the
+     * end of the previous tick, no matter which order they are ticked in.
+     *
+     * Age, and the energy and size of entities whose energy decays, only change
+     * between ticks, so are calculated when read. Entities are only moved
+     * between ticks too, so GetLocation and GetCollide are always consistent.
+     */
+    EntityTraits GetTraits() const;
+    double GetPublishedBearing() const { return publishedBearing_; }
+    double GetPublishedVelocity() const { return publishedSpeed_; }
+    void Publish();
+    /**
+     * The entity's age is measured against the container's tick count, so that
+     * it keeps ageing without being ticked. The age so far is kept.
+     */
+    void SetClock(const uint64_t& tick);
+    /**
+     * Passive entities are never ticked, so must not move or change by
+     * themselves. Instead, any entity that processes its contacts calls
+     * OnContact for each passive entity it is touching. Only other may be
+     * changed, as entities touching the same passive entity may be ticked at
+     * the same time.
+     */
+    virtual bool IsPassive() const { return false; }
+    virtual void OnContact(Entity& /*other*/) { /* Nothing by default */ }
+    /**
+     * Dormant entities aren't ticked while they are at rest, instead their
+     * container schedules them to be ticked again once their age reaches the
+     * wake age. TickImpl is still called while a dormant entity is moving.
+     */
+    bool IsDormant() const { return GetAge() < wakeAge_; }
+    uint64_t GetWakeAge() const { return wakeAge_; }
+
+    void SetLocation(const Point& location) { transform_.x = location.x; transform_.y = location.y; ++transformRevision_; }
+    // Gains efficiency times the energy taken from other
+    void FeedOn(Entity& other, Energy quantity, double efficiency = 1.0);
 
     // returns true if the entity has moved
     bool Tick(EntityContainerInterface& container, const UniverseParameters& universeParameters);
+    /**
+     * Equivalent to Tick, for when the entity is known to be a Concrete, so
+     * that the Concrete::TickImpl can be called (and inlined) directly. The
+     * Concrete type must be final, and befriend Entity.
+     *
+     * The entity is neither moved nor published, so that the container can
+     * move many entities at once afterwards, see SetMovement, then publish
+     * them once no other entity is being ticked.
+     */
+    template <typename Concrete>
+    void TickAs(EntityContainerInterface& container, const UniverseParameters& universeParameters)
+    {
+        static_assert(std::is_final_v<Concrete> && std::is_base_of_v<Entity, Concrete>);
+        static_cast<Concrete&>(*this).Concrete::TickImpl(container, universeParameters);
+    }
+    /**
+     * Sets the result of moving forwards by GetVelocity along GetHeading, and
+     * the velocity reduced by SPEED_RETAINED_PER_TICK, as Tick would have.
+     */
+    void SetMovement(const Point& location, double speed) { transform_.x = location.x; transform_.y = location.y; speed_ = speed; ++transformRevision_; }
     void Draw(QPainter& paint, const DrawSettings& options);
 
 protected:
     virtual void TickImpl(EntityContainerInterface& container, const UniverseParameters& universeParameters) = 0;
     virtual void DrawExtras(QPainter& paint, const DrawSettings& options) { /* Nothing by default */ }
 
-    void UseEnergy(Energy quantity) { energy_ -= quantity; }
+    void UseEnergy(Energy quantity) { SetEnergy(GetEnergy() - quantity); }
     Energy TakeEnergy(Energy quantity);
     void Terminate() { terminated_ = true; }
 
     void SetColour(double red, double green, double blue) { colour_.setRgbF(red, green, blue); }
     void SetBearing(double bearing);
     void SetVelocity(double speed) { speed_ = speed; }
-    void SetRadius(double radius) { radius_ = radius; }
+    void SetRadius(double radius) { radius_ = radius; ++transformRevision_; }
+    /**
+     * The entity's energy will be multiplied by retainedPerTick each tick, and
+     * it will cease to exist once its energy is below minimum. Both are
+     * calculated from the entity's age when required, so the entity doesn't
+     * need to be ticked. If energyToRadius is set, the radius is also derived
+     * from the current energy.
+     */
+    void SetEnergyDecay(double retainedPerTick, Energy minimum, double (*energyToRadius)(const Energy& energy) = nullptr);
+    void SetWakeAge(uint64_t age) { wakeAge_ = age; }
 
 private:
+    const EntityType type_;
     Energy energy_; // TODO consider tracking energy used recenty via some sort of low pass filtered heat variable that decays over time
     bool terminated_ = false;
     Transform transform_;
+    Heading heading_;
+    uint64_t transformRevision_;
     double radius_;
     double speed_;
-    uint64_t age_;
+    const uint64_t* clock_;
+    uint64_t birthTick_;
+    uint64_t wakeAge_;
+    // energy_ was exact at energyAge_, and decays from there
+    double energyRetainedPerTick_;
+    Energy minimumEnergy_;
+    uint64_t energyAge_;
+    uint64_t expiryAge_;
+    double (*energyToRadius_)(const Energy& energy);
     QColor colour_;
     std::shared_ptr<QPixmap> pixmap_;
+    // The state read by other entities, see Publish
+    EntityTraits publishedTraits_;
+    double publishedBearing_;
+    double publishedSpeed_;
 
     virtual std::vector<Property> CollectProperties() const { return {}; /* No extra properties by default */ }
 
+    double GetDecayedEnergy() const;
+    void SetEnergy(Energy energy);
+
     // returns true if the entity has moved
     bool Move();
 };
@@ -1,33 +1,71 @@
 #ifndef ENTITYCONTAINERINTERFACE_H
 #define ENTITYCONTAINERINTERFACE_H
 
+#include "EntityTraits.h"
+
 #include <Shape.h>
+#include <Energy.h>
 
 #include <memory>
 #include <functional>
+#include <cstdint>
 
 class Entity;
 class EntityContainerInterface {
 public:
     virtual ~EntityContainerInterface(){}
     virtual void AddEntity(std::shared_ptr<Entity> entity) = 0;
-    virtual void ForEachCollidingWith(const Point& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action) = 0;
-    virtual void ForEachCollidingWith(const Line& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action) = 0;
-    virtual void ForEachCollidingWith(const Rect& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action) = 0;
-    virtual void ForEachCollidingWith(const Circle& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action) = 0;
-    virtual void ForEachCollidingWith(const Point& collide, const std::function<void(const Entity&)>& action) const = 0;
-    virtual void ForEachCollidingWith(const Line& collide, const std::function<void(const Entity&)>& action) const = 0;
-    virtual void ForEachCollidingWith(const Rect& collide, const std::function<void(const Entity&)>& action) const = 0;
-    virtual void ForEachCollidingWith(const Circle& collide, const std::function<void(const Entity&)>& action) const = 0;
+    /**
+     * Entities must not change other entities directly while being ticked,
+     * instead they request the change from the container, which may defer it
+     * until every entity has been ticked (see CommandBuffer).
+     *
+     * The eater gains efficiency times whatever energy it actually takes from
+     * the food, which may be less than quantity if the food has already been
+     * eaten.
+     */
+    virtual void FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency = 1.0) = 0;
+    virtual void Damage(Entity& victim, double damage) = 0;
+    /**
+     * Only entities whose type is within types are passed to action, which
+     * allows regions containing none of the requested types to be skipped.
+     */
+    virtual void ForEachCollidingWith(const Point& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) = 0;
+    virtual void ForEachCollidingWith(const Line& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) = 0;
+    virtual void ForEachCollidingWith(const Rect& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) = 0;
+    virtual void ForEachCollidingWith(const Circle& collide, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) = 0;
+    virtual void ForEachCollidingWith(const Point& collide, const std::function<void(const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const = 0;
+    virtual void ForEachCollidingWith(const Line& collide, const std::function<void(const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const = 0;
+    virtual void ForEachCollidingWith(const Rect& collide, const std::function<void(const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const = 0;
+    virtual void ForEachCollidingWith(const Circle& collide, const std::function<void(const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const = 0;
+    /**
+     * Regions entirely within the area are passed as a total to totalAction,
+     * along with the region's bounds. Entities in any other region that might
+     * be within the area are passed individually to action, so they still need
+     * to be filtered.
+     */
+    virtual void ForEachTotalWithin(const Circle& area, const std::function<void(const Rect& region, const EntityTraitTotals& total)>& totalAction, const std::function<void(const Entity&)>& action) const = 0;
+    /**
+     * Entities whose collides overlapped the specified entity's collide at the
+     * start of the tick are passed to action, not including the entity itself.
+     */
+    virtual void ForEachContact(const Entity& entity, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) = 0;
+    /**
+     * Entities added during or after the specified tick, that can now be found
+     * by the ForEachCollidingWith functions, are passed to action. Only
+     * required while UniverseParameters::neighbourListSkin_ is set, and only
+     * for ticks within UniverseParameters::neighbourListMaxAge_.
+     */
+    virtual void ForEachAddedSince(uint64_t tick, const std::function<void(const std::shared_ptr<Entity>&)>& action) const = 0;
 
     template <typename Shape>
-    unsigned CountEntities(const Shape& collide) const
+    unsigned CountEntities(const Shape& collide, EntityTypeMask types = ALL_ENTITY_TYPES) const
     {
         unsigned count = 0;
         ForEachCollidingWith(collide, [&](const Entity&)
         {
             ++count;
-        });
+        }, types);
         return count;
     }
 };
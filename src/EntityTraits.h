@@ -0,0 +1,67 @@
+#ifndef ENTITYTRAITS_H
+#define ENTITYTRAITS_H
+
+#include <cstdint>
+#include <cstddef>
+
+class Entity;
+
+/**
+ * Allows entities of a particular type to be found without a dynamic_cast, and
+ * allows searches to skip over regions containing none of the types required.
+ */
+enum class EntityType : uint8_t {
+    Trilobyte,
+    Egg,
+    FoodPellet,
+    MeatChunk,
+    Spike,
+};
+
+constexpr size_t ENTITY_TYPE_COUNT = static_cast<size_t>(EntityType::Spike) + 1;
+
+using EntityTypeMask = uint32_t;
+
+constexpr EntityTypeMask ALL_ENTITY_TYPES = ~EntityTypeMask{ 0 };
+
+template <typename... Types>
+constexpr EntityTypeMask MaskOf(Types... types)
+{
+    return ((EntityTypeMask{ 1 } << static_cast<unsigned>(types)) | ... | EntityTypeMask{ 0 });
+}
+
+/**
+ * The values that other entities can sense, published once every entity has
+ * been ticked (and when added to a container), so that the many senses that
+ * detect an entity each tick can read them without any conversion, and all
+ * read the same values. Age, and the energy and size of entities whose energy
+ * decays, are the exception, they change without the entity being ticked, so
+ * are filled in when read.
+ */
+struct EntityTraits {
+    double red = 0.0;
+    double green = 0.0;
+    double blue = 0.0;
+    double energy = 0.0;
+    double age = 0.0;
+    double size = 0.0;
+    double health = 0.0;
+};
+
+/**
+ * The total of the traits of a number of entities, maintained for each quad in
+ * the Universe's QuadTree so that senses covering a large area can detect the
+ * entities in whole quads at once. The types present allow searches for
+ * particular types to skip whole quads.
+ */
+struct EntityTraitTotals {
+    unsigned count = 0;
+    EntityTraits sum;
+    EntityTypeMask types = 0;
+
+    void Add(const Entity& entity);
+    void Add(const EntityTraitTotals& other);
+    void Remove(const Entity& entity);
+};
+
+#endif // ENTITYTRAITS_H
@@ -11,7 +11,7 @@ double FoodPellet::GetPelletRadius(const Energy& energy)
 }
 
 FoodPellet::FoodPellet(Energy energy, const Transform& transform)
-    : Entity(transform, GetPelletRadius(energy), QColor::fromRgb(15, 235, 15), energy)
+    : Entity(EntityType::FoodPellet, transform, GetPelletRadius(energy), QColor::fromRgb(15, 235, 15), energy)
 {
 }
 
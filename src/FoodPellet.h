@@ -5,7 +5,7 @@
 
 class QPainter;
 
-class FoodPellet : public Entity {
+class FoodPellet final : public Entity {
 public:
     static double GetPelletRadius(const Energy& energy);
 
@@ -14,6 +14,7 @@ public:
 
     std::string_view GetName() const override { return "FoodPellet"; }
     std::string_view GetDescription() const override;
+    bool IsPassive() const override { return true; }
 
 private:
     void TickImpl(EntityContainerInterface& /*container*/, const UniverseParameters& /*universeParameters*/) override final {}
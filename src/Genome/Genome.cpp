@@ -71,9 +71,73 @@ Phenotype Genome::GetPhenoType(Trilobyte& owner) const
     if (!phenotype.brain) {
         phenotype.brain = std::make_shared<NeuralNetwork>(1, NeuralNetwork::BRAIN_WIDTH, NeuralNetwork::InitialWeights::PassThrough);
     }
+    EliminateDeadSensesAndEffectors(phenotype);
     return phenotype;
 }
 
+void Genome::EliminateDeadSensesAndEffectors(Phenotype& phenotype)
+{
+    const NeuralNetwork& brain = *phenotype.brain;
+
+    // Which brain outputs are read by an effector
+    std::vector<bool> usedBrainOutputs(brain.GetOutputCount(), false);
+    for (const auto& effector : phenotype.effectors) {
+        const auto& weights = effector->InspectConnection().Inspect();
+        for (size_t brainOutput = 0; brainOutput < weights.size() && brainOutput < usedBrainOutputs.size(); ++brainOutput) {
+            for (double weight : weights.at(brainOutput)) {
+                if (weight != 0.0) {
+                    usedBrainOutputs.at(brainOutput) = true;
+                    break;
+                }
+            }
+        }
+    }
+    const std::vector<bool> liveBrainInputs = brain.GetInputsAffecting(usedBrainOutputs);
+
+    // A sense is only worth ticking if it can change one of those brain inputs
+    std::vector<bool> drivenBrainInputs(brain.GetInputCount(), false);
+    for (const auto& sense : phenotype.senses) {
+        const auto& weights = sense->InspectConnection().Inspect();
+        std::vector<bool> liveSenseOutputs(weights.size(), false);
+        for (size_t senseOutput = 0; senseOutput < weights.size(); ++senseOutput) {
+            const auto& outputWeights = weights.at(senseOutput);
+            for (size_t brainInput = 0; brainInput < outputWeights.size() && brainInput < liveBrainInputs.size(); ++brainInput) {
+                if (outputWeights.at(brainInput) != 0.0 && liveBrainInputs.at(brainInput)) {
+                    liveSenseOutputs.at(senseOutput) = true;
+                }
+            }
+        }
+
+        const std::vector<bool> liveSenseInputs = sense->Inspect().GetInputsAffecting(liveSenseOutputs);
+        const bool active = std::find(std::cbegin(liveSenseInputs), std::cend(liveSenseInputs), true) != std::cend(liveSenseInputs);
+        sense->SetActive(active);
+
+        if (active) {
+            for (size_t senseOutput = 0; senseOutput < weights.size(); ++senseOutput) {
+                const auto& outputWeights = weights.at(senseOutput);
+                for (size_t brainInput = 0; brainInput < outputWeights.size() && brainInput < drivenBrainInputs.size(); ++brainInput) {
+                    if (outputWeights.at(brainInput) != 0.0) {
+                        drivenBrainInputs.at(brainInput) = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Brain outputs not reachable from an active sense are always 0.0
+    const std::vector<bool> drivenBrainOutputs = brain.GetOutputsAffectedBy(drivenBrainInputs);
+    for (const auto& effector : phenotype.effectors) {
+        const auto& weights = effector->InspectConnection().Inspect();
+        bool constant = true;
+        for (size_t brainOutput = 0; constant && brainOutput < weights.size(); ++brainOutput) {
+            if (brainOutput < drivenBrainOutputs.size() && drivenBrainOutputs.at(brainOutput)) {
+                constant = std::all_of(std::cbegin(weights.at(brainOutput)), std::cend(weights.at(brainOutput)), [](double weight) { return weight == 0.0; });
+            }
+        }
+        effector->SetInputsConstant(constant);
+    }
+}
+
 void Genome::ForEach(const std::function<void (const Gene&)>& action) const {
     for (const ChromosomePair& chromosome : chromosomes_) {
         chromosome.ForEach(action);
@@ -44,6 +44,14 @@ private:
     std::vector<ChromosomePair> chromosomes_;
 
     void ForEach(const std::function<void(const Gene& gene)>& action) const;
+
+    /**
+     * Random genomes in particular express plenty of senses that aren't
+     * connected to anything, and effectors whose inputs aren't driven by any
+     * sense. Disables senses that can't affect an effector, and lets effectors
+     * that only ever see 0.0 re-use their outputs.
+     */
+    static void EliminateDeadSensesAndEffectors(Phenotype& phenotype);
 };
 
 template<>
@@ -140,6 +140,8 @@ MainWindow::MainWindow(QWidget *parent)
 
     /// Spawner Controlls
     connect(ui->spawnEntitiesToggle, &QPushButton::toggled, this, [&](bool state) { universe_->GetParameters().spawnRateModifier = state ? 1.0 : 0.0; }, Qt::QueuedConnection);
+    connect(ui->memoiseBrainsToggle, &QPushButton::toggled, this, [&](bool state) { universe_->GetParameters().memoiseBrainEvaluation_ = state; }, Qt::QueuedConnection);
+    connect(ui->neighbourListsToggle, &QPushButton::toggled, this, [&](bool state) { universe_->GetParameters().neighbourListSkin_ = state ? 10.0 : 0.0; }, Qt::QueuedConnection);
 
     ui->newSpawnerShapeCombo->addItem("Square", QVariant::fromValue(Spawner::Shape::Square));
     ui->newSpawnerShapeCombo->addItem("Circle", QVariant::fromValue(Spawner::Shape::Circle));
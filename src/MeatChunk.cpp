@@ -5,8 +5,10 @@
 #include <QPainter>
 
 MeatChunk::MeatChunk(const Energy& energy, const Transform& transform, const double& speed)
-    : Entity(transform, GetMeatChunkRadius(energy), QColor::fromRgb(184, 68, 68), energy, speed)
+    : Entity(EntityType::MeatChunk, transform, GetMeatChunkRadius(energy), QColor::fromRgb(184, 68, 68), energy, speed)
 {
+    // Lose 1/500th of our energy each tick, until there is almost nothing left
+    SetEnergyDecay(499.0 / 500.0, 1_mj, &GetMeatChunkRadius);
 }
 
 MeatChunk::~MeatChunk()
@@ -26,12 +28,3 @@ std::string_view MeatChunk::GetDescription() const
            "When a trilobyte loses all of its health, all remaining energy is converted into meat chunks, "
            "which are scattered near the body of the deceased trilobyte.</p>";
 }
-
-void MeatChunk::TickImpl(EntityContainerInterface& /*container*/, const UniverseParameters& /*universeParameters*/)
-{
-    UseEnergy(GetEnergy() / 500.0);
-    SetRadius(GetMeatChunkRadius(GetEnergy()));
-    if (GetEnergy() < 1_mj) {
-        Terminate();
-    }
-}
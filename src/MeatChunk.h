@@ -3,7 +3,7 @@
 
 #include "Entity.h"
 
-class MeatChunk : public Entity {
+class MeatChunk final : public Entity {
 public:
     MeatChunk(const Energy& energy, const Transform& transform, const double& speed);
     ~MeatChunk() override;
@@ -12,9 +12,16 @@ public:
 
     virtual std::string_view GetName() const override { return "MeatChunk"; }
     virtual std::string_view GetDescription() const override;
+    // Decay is calculated as required, so there is no need to tick once we've stopped
+    virtual bool IsPassive() const override { return IsAtRest(); }
 
 protected:
-    virtual void TickImpl(EntityContainerInterface& container, const UniverseParameters& universeParameters) override final;
+    friend class Entity; // For TickAs
+
+    virtual void TickImpl(EntityContainerInterface& /*container*/, const UniverseParameters& /*universeParameters*/) override final
+    {
+        // Nothing to do, our energy and size are derived from our age
+    }
 
 private:
     virtual std::vector<Property> CollectProperties() const override { return {}; }
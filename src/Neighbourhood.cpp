@@ -0,0 +1,151 @@
+#include "Neighbourhood.h"
+
+#include "Entity.h"
+
+#include <algorithm>
+#include <utility>
+
+bool NeighbourList::CanReuse(const Circle& area, const UniverseParameters& params) const
+{
+    if (!reusable_ || params.neighbourListSkin_ <= 0.0 || gatheredTick_ < params.neighbourListsValidFrom_ || params.tick_ - gatheredTick_ >= params.neighbourListMaxAge_) {
+        return false;
+    }
+    /*
+     * An entity that wasn't gathered was further than the gathered radius from
+     * the gathered centre, so it can only now be within the area if the centre
+     * and the entity have moved a combined distance greater than the skin.
+     */
+    double ownerDisplacement = GetDistance({ area.x, area.y }, { gathered_.x, gathered_.y });
+    double entityDisplacement = params.totalMaxDisplacement_ - displacementWhenGathered_;
+    return area.radius + ownerDisplacement + entityDisplacement <= gathered_.radius;
+}
+
+Neighbourhood::Neighbourhood(EntityContainerInterface& entities, const Circle& area, NeighbourList& list, const UniverseParameters& params)
+    : entities_(entities)
+    , area_(area)
+    , list_(list)
+    , neighbours_(list.entities_)
+{
+    if (list_.CanReuse(area_, params)) {
+        Update(params);
+    } else {
+        Gather(params);
+    }
+}
+
+Neighbourhood::~Neighbourhood()
+{
+    if (!list_.reusable_) {
+        // Don't keep our neighbours alive until next tick
+        neighbours_.clear();
+    }
+}
+
+void Neighbourhood::Gather(const UniverseParameters& params)
+{
+    list_.gathered_ = { area_.x, area_.y, area_.radius + std::max(0.0, params.neighbourListSkin_) };
+    list_.displacementWhenGathered_ = params.totalMaxDisplacement_;
+    list_.gatheredTick_ = params.tick_;
+    list_.updatedTick_ = params.tick_;
+    list_.reusable_ = params.neighbourListSkin_ > 0.0;
+
+    neighbours_.clear();
+    entities_.ForEachCollidingWith(list_.gathered_, [&](const std::shared_ptr<Entity>& entity)
+    {
+        neighbours_.push_back(entity);
+    });
+}
+
+void Neighbourhood::Update(const UniverseParameters& params)
+{
+    neighbours_.erase(std::remove_if(std::begin(neighbours_), std::end(neighbours_), [](const std::shared_ptr<Entity>& entity)
+    {
+        return !entity->Exists();
+    }), std::end(neighbours_));
+
+    entities_.ForEachAddedSince(list_.updatedTick_, [&](const std::shared_ptr<Entity>& entity)
+    {
+        if (Collides(list_.gathered_, entity->GetCollide()) && std::find(std::cbegin(neighbours_), std::cend(neighbours_), entity) == std::cend(neighbours_)) {
+            neighbours_.push_back(entity);
+        }
+    });
+    list_.updatedTick_ = params.tick_;
+}
+
+template <typename Shape>
+void Neighbourhood::ForEachNeighbourCollidingWith(const Shape& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    if (Contains(area_, collide)) {
+        for (const auto& neighbour : neighbours_) {
+            if ((neighbour->GetTypeMask() & types) && Collides(collide, neighbour->GetCollide())) {
+                action(neighbour);
+            }
+        }
+    } else {
+        entities_.ForEachCollidingWith(collide, action, types);
+    }
+}
+
+template <typename Shape>
+void Neighbourhood::ForEachNeighbourCollidingWith(const Shape& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
+{
+    if (Contains(area_, collide)) {
+        for (const auto& neighbour : neighbours_) {
+            if ((neighbour->GetTypeMask() & types) && Collides(collide, neighbour->GetCollide())) {
+                action(*neighbour);
+            }
+        }
+    } else {
+        std::as_const(entities_).ForEachCollidingWith(collide, action, types);
+    }
+}
+
+void Neighbourhood::ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
+{
+    ForEachNeighbourCollidingWith(collide, action, types);
+}
+
+void Neighbourhood::ForEachTotalWithin(const Circle& area, const std::function<void (const Rect&, const EntityTraitTotals&)>& totalAction, const std::function<void (const Entity&)>& action) const
+{
+    if (Contains(area_, area)) {
+        // Totals would be no quicker than our short list of neighbours
+        ForEachNeighbourCollidingWith(area, action, ALL_ENTITY_TYPES);
+    } else {
+        entities_.ForEachTotalWithin(area, totalAction, action);
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef NEIGHBOURHOOD_H
+#define NEIGHBOURHOOD_H
+
+#include "EntityContainerInterface.h"
+#include "UniverseParameters.h"
+
+#include <Shape.h>
+
+#include <vector>
+
+/**
+ * @brief The entities gathered by a Neighbourhood. When
+ * UniverseParameters::neighbourListSkin_ is set, the entities are gathered from
+ * a larger area, and the list is kept by the owner and re-used in later ticks,
+ * for as long as no entity (including the owner) could have moved far enough
+ * to be missed. Entities added to the container since are merged in.
+ */
+class NeighbourList {
+private:
+    friend class Neighbourhood;
+
+    std::vector<std::shared_ptr<Entity>> entities_;
+    Circle gathered_ = { 0.0, 0.0, 0.0 };
+    double displacementWhenGathered_ = 0.0;
+    uint64_t gatheredTick_ = 0;
+    uint64_t updatedTick_ = 0;
+    bool reusable_ = false;
+
+    bool CanReuse(const Circle& area, const UniverseParameters& params) const;
+};
+
+/**
+ * @brief Gathers every entity colliding with an area using a single search of
+ * the underlying container, so that the senses and effectors of an entity can
+ * each filter the short list of neighbours rather than each searching the
+ * entire container again.
+ *
+ * Queries which reach outside of the gathered area are passed on to the
+ * underlying container, as are any new entities.
+ *
+ * The neighbours are only gathered once, so the Neighbourhood should only live
+ * while the entities within it are not moving, i.e. for a single TickImpl.
+ * Any NeighbourList re-used from an earlier tick is brought up to date first.
+ */
+class Neighbourhood final : public EntityContainerInterface {
+public:
+    /**
+     * The list is intended to be kept by the owner between ticks, so that its
+     * capacity doesn't need to grow again, and so it can be re-used.
+     */
+    Neighbourhood(EntityContainerInterface& entities, const Circle& area, NeighbourList& list, const UniverseParameters& params);
+    ~Neighbourhood() override;
+
+    void AddEntity(std::shared_ptr<Entity> entity) override { entities_.AddEntity(entity); }
+    void FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency = 1.0) override { entities_.FeedOn(eater, food, quantity, efficiency); }
+    void Damage(Entity& victim, double damage) override { entities_.Damage(victim, damage); }
+    void ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override;
+    void ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override;
+    void ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override;
+    void ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override;
+    void ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override;
+    void ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override;
+    void ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override;
+    void ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override;
+    void ForEachTotalWithin(const Circle& area, const std::function<void(const Rect& region, const EntityTraitTotals& total)>& totalAction, const std::function<void(const Entity&)>& action) const override;
+    void ForEachContact(const Entity& entity, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override { entities_.ForEachContact(entity, action, types); }
+    void ForEachAddedSince(uint64_t tick, const std::function<void(const std::shared_ptr<Entity>&)>& action) const override { entities_.ForEachAddedSince(tick, action); }
+
+private:
+    EntityContainerInterface& entities_;
+    const Circle area_;
+    NeighbourList& list_;
+    std::vector<std::shared_ptr<Entity>>& neighbours_;
+
+    void Gather(const UniverseParameters& params);
+    void Update(const UniverseParameters& params);
+
+    template <typename Shape>
+    void ForEachNeighbourCollidingWith(const Shape& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types);
+    template <typename Shape>
+    void ForEachNeighbourCollidingWith(const Shape& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const;
+};
+
+#endif // NEIGHBOURHOOD_H
@@ -30,7 +30,7 @@ void NeuralNetworkInspector::SetTrilobyte(std::shared_ptr<Trilobyte> toInspect)
             }
 
             for (auto& sense : inspectedTrilobyte_->InspectSenses()) {
-                sensorGroups_.push_back(CreateGroup(sense->Inspect(), std::string(sense->GetName()), sense->GetDescription()));
+                sensorGroups_.push_back(CreateGroup(sense->Inspect(), std::string(sense->GetName()) + (sense->IsActive() ? "" : " (inactive)"), sense->GetDescription()));
                 Group& senseGroup = sensorGroups_.back();
 
                 unsigned neuronIndex = 0;
@@ -58,7 +58,7 @@ void NeuralNetworkInspector::SetTrilobyte(std::shared_ptr<Trilobyte> toInspect)
             }
 
             for (auto& effector : inspectedTrilobyte_->InspectEffectors()) {
-                effectorGroups_.push_back(CreateGroup(effector->Inspect(), std::string(effector->GetName()), std::string(effector->GetDescription())));
+                effectorGroups_.push_back(CreateGroup(effector->Inspect(), std::string(effector->GetName()) + (effector->HasConstantInputs() ? " (constant)" : ""), std::string(effector->GetDescription())));
                 Group& effectorGroup = effectorGroups_.back();
 
                 unsigned neuronIndex = 0;
@@ -331,7 +331,11 @@ std::string NeuralNetworkInspector::GetBrainDescription() const
     "<p>Sometimes an input node will contain a value greater than 1 and will be"
     " drawn larger than normal, this occurs because input values are not "
     "constrained, however when they are passed forward, part of the process "
-    "normalises the values to between -1 and 1.</p>";
+    "normalises the values to between -1 and 1.</p>"
+
+    "<p>Senses marked as inactive have no connections that could affect an "
+    "effector, so are not calculated each tick. Effectors marked as constant "
+    "are not connected to any active sense, so their outputs never change.</p>";
 }
 
 NeuralNetworkInspector::Group NeuralNetworkInspector::CreateGroup(const NeuralNetwork& network, const std::string& name, const std::string& description)
@@ -10,6 +10,7 @@ Sense::Sense(const std::shared_ptr<NeuralNetwork>& network, const std::shared_pt
     , network_(network)
     , outputConnections_(outputConnections)
     , inputs_(outputConnections->GetInputCount(), 0.0)
+    , active_(true)
 {
 }
 
@@ -23,11 +24,31 @@ void Sense::Draw(QPainter& /*paint*/) const
 }
 
 void Sense::Tick(std::vector<double>& outputs, const EntityContainerInterface& entities, const UniverseParameters& universeParameters)
+{
+    if (!active_) {
+        return;
+    }
+
+    if (IsGlobal()) {
+        std::lock_guard lock(universeParameters.globalSenseOutputsMutex_);
+        auto [ cached, inserted ] = universeParameters.globalSenseOutputs_.try_emplace(network_);
+        if (inserted) {
+            Propogate(entities, universeParameters);
+            cached->second = inputs_;
+        } else {
+            inputs_ = cached->second;
+        }
+    } else {
+        Propogate(entities, universeParameters);
+    }
+    outputConnections_->PassForward(inputs_, outputs);
+}
+
+void Sense::Propogate(const EntityContainerInterface& entities, const UniverseParameters& universeParameters)
 {
     std::fill(std::begin(inputs_), std::end(inputs_), 0.0);
     PrepareToPrime();
     PrimeInputs(inputs_, entities, universeParameters);
     network_->ForwardPropogate(inputs_);
-    outputConnections_->PassForward(inputs_, outputs);
 }
 
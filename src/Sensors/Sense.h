@@ -26,6 +26,17 @@ public:
 
     virtual std::string_view GetName() const = 0;
     virtual std::string GetDescription() const = 0;
+    /**
+     * Global senses have no per-owner state and only prime their inputs from
+     * the UniverseParameters, so every sense sharing the same network outputs
+     * the same values each tick and the result can be shared between them.
+     */
+    virtual bool IsGlobal() const { return false; }
+    /**
+     * The furthest distance from the owner's centre at which this sense can
+     * detect anything, used to gather the owner's Neighbourhood.
+     */
+    virtual double GetReach() const { return 0.0; }
 
     virtual void PrimeInputs(std::vector<double>& inputs, const EntityContainerInterface& entities, const UniverseParameters& universeParameters) const = 0;
 
@@ -33,6 +44,12 @@ public:
     virtual void Tick(std::vector<double>& outputs, const EntityContainerInterface& entities, const UniverseParameters& universeParameters) final;
 
     unsigned GetOutputCount() const { return network_->GetOutputCount(); }
+    /**
+     * Inactive senses can't affect any of their owner's actions, so aren't
+     * ticked, see Genome::GetPhenoType.
+     */
+    void SetActive(bool active) { active_ = active; }
+    bool IsActive() const { return active_; }
 
     const NeuralNetwork& Inspect() const { return *network_; }
     const NeuralNetworkConnector& InspectConnection() const { return *outputConnections_; }
@@ -44,8 +61,10 @@ private:
     std::shared_ptr<NeuralNetwork> network_;
     std::shared_ptr<NeuralNetworkConnector> outputConnections_;
     std::vector<double> inputs_;
+    bool active_;
 
     virtual void PrepareToPrime() {}
+    void Propogate(const EntityContainerInterface& entities, const UniverseParameters& universeParameters);
 };
 
 template<>
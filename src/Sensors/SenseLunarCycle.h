@@ -10,6 +10,7 @@ public:
 
     virtual std::string_view GetName() const override { return "SenseLunarCycle"; }
     virtual std::string GetDescription() const override;
+    virtual bool IsGlobal() const override { return true; }
 
     virtual void PrimeInputs(std::vector<double>& inputs, const EntityContainerInterface& entities, const UniverseParameters& universeParameters) const override;
 };
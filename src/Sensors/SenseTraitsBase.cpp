@@ -72,55 +72,106 @@ SenseTraitsBase::TraitNormaliser SenseTraitsBase::DefaultNormalisation(const Sen
 SenseTraitsBase::SenseTraitsBase(const std::shared_ptr<NeuralNetwork>& network, const std::shared_ptr<NeuralNetworkConnector>& outputConnections, const Trilobyte& owner, const Transform& transform, std::vector<TraitNormaliser>&& toDetect)
     : Sense(network, outputConnections, owner)
     , transform_(transform)
+    , offset_(LocalOffset::FromPolar(transform.rotation, GetDistance({ 0, 0 }, { transform.x, transform.y })))
     , toDetect_(std::move(toDetect))
+    , kernel_(SelectKernel(TraitMask(toDetect_)))
 {
 }
 
 void SenseTraitsBase::PrimeInputs(std::vector<double>& inputs, const EntityContainerInterface& entities, const UniverseParameters& /*universeParameters*/) const
 {
-    // First adjust inputs for each entity detected
-    FilterEntities(entities, [&](const Entity& entity)
-    {
-        Tril::IterateBoth<TraitNormaliser, double>(toDetect_, inputs, [&](const TraitNormaliser& norm, double& input)
-        {
-            input += GetTraitFrom(entity, norm.trait);
-        });
-    });
+    // First total each detected trait over every entity detected
+    TraitSums sums{};
+    kernel_(*this, entities, sums);
+
     // Then normalise each input according to its normalisation range
     Tril::IterateBoth<TraitNormaliser, double>(toDetect_, inputs, [&](const TraitNormaliser& norm, double& input)
     {
-        input = norm.range.ConvertAndClamp(input);
+        input = norm.range.ConvertAndClamp(input + sums.at(static_cast<size_t>(norm.trait)));
     });
 }
 
-double SenseTraitsBase::GetTraitFrom(const Entity& target, Trait trait) const
+void SenseTraitsBase::FilterEntityTotals(const EntityContainerInterface& entities, const std::function<void (const EntityTraitTotals&)>& /*forEachTotal*/, const std::function<void (const Entity&)>& forEachEntity) const
 {
-    switch (trait) {
-    case Trait::Red :
-        return target.GetColour().redF();
-    case Trait::Green :
-        return target.GetColour().greenF();
-    case Trait::Blue :
-        return target.GetColour().blueF();
-    case Trait::Energy :
-        return target.GetEnergy();
-    case Trait::Age :
-        return target.GetAge();
-    case Trait::Size :
-        return target.GetRadius();
-    case Trait::Distance : {
-        Transform senseLocation = transform_ + owner_.GetTransform();
-        return GetDistance({ senseLocation.x, senseLocation.y }, target.GetLocation());
+    FilterEntities(entities, forEachEntity);
+}
+
+unsigned SenseTraitsBase::TraitMask(const std::vector<SenseTraitsBase::TraitNormaliser>& traits)
+{
+    unsigned mask = 0;
+    for (const TraitNormaliser& norm : traits) {
+        mask |= TraitBit(norm.trait);
     }
-    case Trait::Health :
-        if (const Trilobyte* targetTrilobyte = dynamic_cast<const Trilobyte*>(&target)) {
-            return targetTrilobyte->GetHealth();
-        } else {
-            return 0.0;
+    return mask;
+}
+
+template <unsigned Mask>
+void SenseTraitsBase::AccumulateTraits(const SenseTraitsBase& sense, const EntityContainerInterface& entities, SenseTraitsBase::TraitSums& sums)
+{
+    constexpr auto has = [](Trait trait) { return (Mask & TraitBit(trait)) != 0; };
+    constexpr auto index = [](Trait trait) { return static_cast<size_t>(trait); };
+
+    if constexpr (Mask == 0) {
+        // Nothing to detect, so no need to look for entities
+        return;
+    }
+
+    auto accumulate = [&](const EntityTraits& traits, unsigned count)
+    {
+        if constexpr (has(Trait::Red)) {
+            sums[index(Trait::Red)] += traits.red;
         }
-    case Trait::Presence :
-        return 1.0;
+        if constexpr (has(Trait::Green)) {
+            sums[index(Trait::Green)] += traits.green;
+        }
+        if constexpr (has(Trait::Blue)) {
+            sums[index(Trait::Blue)] += traits.blue;
+        }
+        if constexpr (has(Trait::Energy)) {
+            sums[index(Trait::Energy)] += traits.energy;
+        }
+        if constexpr (has(Trait::Age)) {
+            sums[index(Trait::Age)] += traits.age;
+        }
+        if constexpr (has(Trait::Size)) {
+            sums[index(Trait::Size)] += traits.size;
+        }
+        if constexpr (has(Trait::Health)) {
+            sums[index(Trait::Health)] += traits.health;
+        }
+        if constexpr (has(Trait::Presence)) {
+            sums[index(Trait::Presence)] += count;
+        }
+    };
+
+    if constexpr (has(Trait::Distance)) {
+        // Distance has to be calculated for each entity individually
+        Transform senseTransform = sense.transform_ + sense.owner_.GetTransform();
+        Point senseLocation = { senseTransform.x, senseTransform.y };
+        sense.FilterEntities(entities, [&](const Entity& entity)
+        {
+            accumulate(entity.GetTraits(), 1);
+            sums[index(Trait::Distance)] += GetDistance(senseLocation, entity.GetLocation());
+        });
+    } else {
+        sense.FilterEntityTotals(entities, [&](const EntityTraitTotals& totals)
+        {
+            accumulate(totals.sum, totals.count);
+        }, [&](const Entity& entity)
+        {
+            accumulate(entity.GetTraits(), 1);
+        });
     }
-    assert(false && "Entity::GetTrait, unimplemented trait.");
-    return 0.0;
+}
+
+template <size_t... TraitMasks>
+constexpr std::array<SenseTraitsBase::Kernel, sizeof...(TraitMasks)> SenseTraitsBase::CreateKernels(std::index_sequence<TraitMasks...>)
+{
+    return { &AccumulateTraits<TraitMasks>... };
+}
+
+SenseTraitsBase::Kernel SenseTraitsBase::SelectKernel(unsigned traitMask)
+{
+    static constexpr auto kernels = CreateKernels(std::make_index_sequence<1u << ALL_TRAITS.size()>());
+    return kernels.at(traitMask);
 }
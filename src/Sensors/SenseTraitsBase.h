@@ -2,6 +2,7 @@
 #define SENSETRAITSBASE_H
 
 #include "Sense.h"
+#include "EntityTraits.h"
 
 #include <Energy.h>
 #include <Transform.h>
@@ -11,6 +12,8 @@
 #include <nlohmann/json.hpp>
 
 #include <functional>
+#include <array>
+#include <utility>
 
 class Entity;
 
@@ -66,17 +69,41 @@ public:
 
 protected:
     const Transform transform_;
+    /**
+     * The position of the sense relative to its owner, ready to be rotated by
+     * the owner's Heading.
+     */
+    const LocalOffset offset_;
 
 private:
     const std::vector<TraitNormaliser> toDetect_;
 
     /**
-     * This allows senses to respond to any trait easily, it is up to the caller
-     * to normalise the value.
+     * The sum of each trait over all detected entities, indexed by Trait.
+     */
+    using TraitSums = std::array<double, ALL_TRAITS.size()>;
+    using Kernel = void(*)(const SenseTraitsBase& sense, const EntityContainerInterface& entities, TraitSums& sums);
+
+    /**
+     * The traits to detect are fixed once the sense is created, so a kernel is
+     * chosen that only accumulates those traits, with no per trait dispatch.
      */
-    double GetTraitFrom(const Entity& target, Trait trait) const;
+    const Kernel kernel_;
+
+    static constexpr unsigned TraitBit(Trait trait) { return 1u << static_cast<unsigned>(trait); }
+    static unsigned TraitMask(const std::vector<TraitNormaliser>& traits);
+    static Kernel SelectKernel(unsigned traitMask);
+    template <unsigned Mask>
+    static void AccumulateTraits(const SenseTraitsBase& sense, const EntityContainerInterface& entities, TraitSums& sums);
+    template <size_t... TraitMasks>
+    static constexpr std::array<Kernel, sizeof...(TraitMasks)> CreateKernels(std::index_sequence<TraitMasks...>);
 
     virtual void FilterEntities(const EntityContainerInterface& entities, const std::function<void(const Entity& e)>& forEachEntity) const = 0;
+    /**
+     * Senses that can detect whole groups of entities at once can override
+     * this, by default every entity is passed individually to forEachEntity.
+     */
+    virtual void FilterEntityTotals(const EntityContainerInterface& entities, const std::function<void(const EntityTraitTotals& totals)>& forEachTotal, const std::function<void(const Entity& e)>& forEachEntity) const;
 };
 
 #endif // SENSETRAITSBASE_H
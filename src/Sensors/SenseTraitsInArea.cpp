@@ -37,16 +37,19 @@ std::string SenseTraitsInArea::GetDescription() const
 }
 void SenseTraitsInArea::Draw(QPainter& paint) const
 {
-    Circle c = GetArea();
+    const Circle& c = GetArea();
     paint.setPen(Qt::black);
     paint.setBrush(Qt::NoBrush);
     paint.drawEllipse(QPointF(c.x, c.y), senseRadius_, senseRadius_);
 }
 
-Circle SenseTraitsInArea::GetArea() const
+const Circle& SenseTraitsInArea::GetArea() const
 {
-    Point centre = ApplyOffset(owner_.GetLocation(), transform_.rotation + owner_.GetTransform().rotation, GetDistance({ 0, 0 }, { transform_.x, transform_.y }));
-    return { centre.x, centre.y, senseRadius_ };
+    return area_.Get(owner_, [&]() -> Circle
+    {
+        Point centre = offset_.ApplyTo(owner_.GetLocation(), owner_.GetHeading());
+        return { centre.x, centre.y, senseRadius_ };
+    });
 }
 
 void SenseTraitsInArea::FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity&)>& forEachEntity) const
@@ -65,3 +68,30 @@ void SenseTraitsInArea::FilterEntities(const EntityContainerInterface& entities,
         }
     });
 }
+
+void SenseTraitsInArea::FilterEntityTotals(const EntityContainerInterface& entities, const std::function<void (const EntityTraitTotals&)>& forEachTotal, const std::function<void (const Entity&)>& forEachEntity) const
+{
+    const Circle senseArea = GetArea();
+    const Point senseCentre = { senseArea.x, senseArea.y };
+    const double senseRadiusSquare = std::pow(senseArea.radius, 2.0);
+    entities.ForEachTotalWithin(senseArea, [&](const Rect& region, const EntityTraitTotals& total)
+    {
+        // don't detect ourself (sleeping regions won't contain our type)
+        if ((total.types & owner_.GetTypeMask()) && Contains(region, owner_.GetLocation())) {
+            EntityTraitTotals others = total;
+            others.Remove(owner_);
+            forEachTotal(others);
+        } else {
+            forEachTotal(total);
+        }
+    }, [&](const Entity& e)
+    {
+        // don't detect ourself
+        if (&e != &owner_) {
+            double distanceSquare = GetDistanceSquare(senseCentre, e.GetLocation());
+            if (distanceSquare < senseRadiusSquare) {
+                forEachEntity(e);
+            }
+        }
+    });
+}
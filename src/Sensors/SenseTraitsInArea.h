@@ -2,6 +2,8 @@
 #define SENSEENTITIESINAREA_H
 
 #include "SenseTraitsBase.h"
+#include "AttachmentGeometry.h"
+
 #include <Shape.h>
 
 class SenseTraitsInArea final : public SenseTraitsBase {
@@ -13,12 +15,16 @@ public:
     virtual std::string GetDescription() const override;
 
     virtual void Draw(QPainter& paint) const override;
+    virtual double GetReach() const override { return GetDistance({ 0, 0 }, { transform_.x, transform_.y }) + senseRadius_; }
 
 private:
     double senseRadius_;
-    Circle GetArea() const;
+    AttachmentGeometry<Circle> area_;
+
+    const Circle& GetArea() const;
 
     virtual void FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity&)>& forEachEntity) const override;
+    virtual void FilterEntityTotals(const EntityContainerInterface& entities, const std::function<void(const EntityTraitTotals& totals)>& forEachTotal, const std::function<void(const Entity& e)>& forEachEntity) const override;
 };
 
 #endif // SENSEENTITIESINAREA_H
@@ -12,6 +12,7 @@ SenseTraitsRaycast::SenseTraitsRaycast(const std::shared_ptr<NeuralNetwork>& net
     : SenseTraitsBase(network, outputConnections, owner, transform, std::move(toDetect))
     , rayCastDistance_(maxDistance)
     , rayCastAngle_(angle)
+    , rayCastOffset_(LocalOffset::FromPolar(transform.rotation + angle, maxDistance))
 {
 }
 
@@ -37,22 +38,24 @@ std::string SenseTraitsRaycast::GetDescription() const
 
 void SenseTraitsRaycast::Draw(QPainter& paint) const
 {
-    auto l = GetLine();
+    const Line& l = GetLine();
     paint.setPen(QColor::fromRgb(0, 0, 0));
     paint.drawLine(QLineF(l.a.x, l.a.y, l.b.x, l.b.y));
 }
 
-Line SenseTraitsRaycast::GetLine() const
+const Line& SenseTraitsRaycast::GetLine() const
 {
-    // TODO this is really why I need to get on with implementing a real transform class...
-    Point begin = ApplyOffset({ owner_.GetTransform().x, owner_.GetTransform().y }, transform_.rotation + owner_.GetTransform().rotation, GetDistance({0, 0}, {transform_.x, transform_.y}));
-    Point end = ApplyOffset(begin, transform_.rotation + owner_.GetTransform().rotation + rayCastAngle_, rayCastDistance_);
-    return { begin, end };
+    return line_.Get(owner_, [&]() -> Line
+    {
+        Point begin = offset_.ApplyTo(owner_.GetLocation(), owner_.GetHeading());
+        Point end = rayCastOffset_.ApplyTo(begin, owner_.GetHeading());
+        return { begin, end };
+    });
 }
 
 void SenseTraitsRaycast::FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity& e)>& forEachEntity) const
 {
-    Line rayCastLine = GetLine();
+    const Line& rayCastLine = GetLine();
     const Entity* nearestEntity = nullptr;
     double distanceToNearestSquared = 0.0;
     entities.ForEachCollidingWith(rayCastLine, [&](const Entity& e)
@@ -2,6 +2,7 @@
 #define SENSEENTITYRAYCAST_H
 
 #include "SenseTraitsBase.h"
+#include "AttachmentGeometry.h"
 
 class SenseTraitsRaycast final : public SenseTraitsBase {
 public:
@@ -12,11 +13,15 @@ public:
     virtual std::string GetDescription() const override;
 
     virtual void Draw(QPainter& paint) const override;
+    virtual double GetReach() const override { return GetDistance({ 0, 0 }, { transform_.x, transform_.y }) + rayCastDistance_; }
 
 private:
     double rayCastDistance_;
     double rayCastAngle_;
-    Line GetLine() const;
+    LocalOffset rayCastOffset_;
+    AttachmentGeometry<Line> line_;
+
+    const Line& GetLine() const;
 
     virtual void FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity&)>& forEachEntity) const override;
 };
@@ -36,20 +36,23 @@ std::string SenseTraitsTouching::GetDescription() const
 
 void SenseTraitsTouching::Draw(QPainter& paint) const
 {
-    Point location = GetPoint();
+    const Point& location = GetPoint();
     paint.setPen(QColor::fromRgb(255, 0, 0));
     paint.setBrush(QColor::fromRgb(0, 0, 0, 0));
     paint.drawEllipse(QPointF(location.x, location.y), 1.0, 1.0);
 }
 
-Point SenseTraitsTouching::GetPoint() const
+const Point& SenseTraitsTouching::GetPoint() const
 {
-    return ApplyOffset(owner_.GetLocation(), transform_.rotation + owner_.GetTransform().rotation, GetDistance({ 0, 0 }, { transform_.x, transform_.y }));
+    return point_.Get(owner_, [&]()
+    {
+        return offset_.ApplyTo(owner_.GetLocation(), owner_.GetHeading());
+    });
 }
 
 void SenseTraitsTouching::FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity&)>& forEachEntity) const
 {
-    Point location = GetPoint();
+    const Point& location = GetPoint();
     entities.ForEachCollidingWith(location, [&](const Entity& e)
     {
         // don't detect ourself
@@ -2,6 +2,8 @@
 #define SENSEENTITIESTOUCHING_H
 
 #include "SenseTraitsBase.h"
+#include "AttachmentGeometry.h"
+
 #include <Shape.h>
 
 class QPainter;
@@ -15,9 +17,12 @@ public:
     virtual std::string GetDescription() const override;
 
     virtual void Draw(QPainter& paint) const override;
+    virtual double GetReach() const override { return GetDistance({ 0, 0 }, { transform_.x, transform_.y }); }
 
 private:
-    Point GetPoint() const;
+    AttachmentGeometry<Point> point_;
+
+    const Point& GetPoint() const;
 
     virtual void FilterEntities(const EntityContainerInterface& entities, const std::function<void (const Entity&)>& forEachEntity) const override;
 };
@@ -119,7 +119,7 @@ std::vector<Property> Spawner::GetProperties()
             "Current Entities",
             [&]()
             {
-                return fmt::format("{}", currentEntityCount_);
+                return fmt::format("{}", currentEntityCount_.load());
             },
             "The number of entites created by this spawner that are still "
             "exist.",
@@ -8,6 +8,7 @@
 #include <Energy.h>
 #include <Shape.h>
 
+#include <atomic>
 #include <memory>
 
 class QPainter;
@@ -59,7 +60,8 @@ private:
     double maxTicksTillNext_;
     double ticksTillNext_;
 
-    unsigned currentEntityCount_;
+    // Entities can be destroyed on any thread
+    std::atomic<unsigned> currentEntityCount_;
     uint64_t totalEntitiesSpawned_ = 0;
 
     Circle GetCircleCollide() const { return Circle{ x_, y_, radius_ }; };
@@ -4,7 +4,7 @@
 #include <QPainter>
 
 Spike::Spike(const Transform& transform) :
-    Entity(transform, RADIUS, QColor::fromRgb(225, 225, 225))
+    Entity(EntityType::Spike, transform, RADIUS, QColor::fromRgb(225, 225, 225))
 {
 }
 
@@ -19,19 +19,22 @@ std::string_view Spike::GetDescription() const
            "By creating areas with different survival pressures you can encourage Trilobytes to speciate to more efficiently fill each unique niche</p>";
 }
 
-void Spike::TickImpl(EntityContainerInterface& container, const UniverseParameters& /*universeParameters*/)
+void Spike::OnContact(Entity& other)
 {
-    container.ForEachCollidingWith(Circle{ GetLocation().x, GetLocation().y, GetRadius() }, [](const std::shared_ptr<Entity>& entity)
-    {
-        if (Trilobyte* trilobyte = dynamic_cast<Trilobyte*>(entity.get())) {
-            // FIXME entity rotation and direction of movement may not actually be the same! (they were when writing, but perhaps that should change!)
-            Vec2 victimVec = GetMovementVector(entity->GetTransform().rotation, entity->GetVelocity());
-
-            auto [ contactBearing, contactVelocity ] = DeconstructMovementVector({ -victimVec.x, -victimVec.y });
-            (void) contactBearing; // unused
-            trilobyte->ApplyDamage(std::pow(contactVelocity, 2.0));
-        }
-    });
+    if (other.GetType() == EntityType::Trilobyte) {
+        Trilobyte& trilobyte = static_cast<Trilobyte&>(other);
+        // FIXME entity rotation and direction of movement may not actually be the same! (they were when writing, but perhaps that should change!)
+        Vec2 victimVec = GetMovementVector(other.GetTransform().rotation, other.GetVelocity());
+
+        auto [ contactBearing, contactVelocity ] = DeconstructMovementVector({ -victimVec.x, -victimVec.y });
+        (void) contactBearing; // unused
+        trilobyte.ApplyDamage(std::pow(contactVelocity, 2.0));
+    }
+}
+
+void Spike::TickImpl(EntityContainerInterface& /*container*/, const UniverseParameters& /*universeParameters*/)
+{
+    // Never called, spikes are passive
 }
 
 std::vector<Property> Spike::CollectProperties() const
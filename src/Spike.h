@@ -3,7 +3,7 @@
 
 #include "Entity.h"
 
-class Spike : public Entity {
+class Spike final : public Entity {
 public:
     constexpr static double RADIUS = 12.0;
 
@@ -12,6 +12,8 @@ public:
 
     virtual std::string_view GetName() const override { return "Spike"; }
     virtual std::string_view GetDescription() const override;
+    virtual bool IsPassive() const override { return true; }
+    virtual void OnContact(Entity& other) override;
 
 protected:
     virtual void TickImpl(EntityContainerInterface& container, const UniverseParameters& universeParameters) override;
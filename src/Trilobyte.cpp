@@ -12,6 +12,7 @@
 
 #include <sstream>
 #include <math.h>
+#include <assert.h>
 
 Trilobyte::Trilobyte(Energy energy, const Transform& transform, std::shared_ptr<Genome> genome)
     : Trilobyte(energy, transform, genome, {})
@@ -63,6 +64,18 @@ unsigned Trilobyte::GetLivingDescendantsCount() const
     });
 }
 
+unsigned Trilobyte::GetElidedLayerCount() const
+{
+    unsigned count = brain_->GetElidedLayerCount();
+    for (const auto& sense : senses_) {
+        count += sense->Inspect().GetElidedLayerCount();
+    }
+    for (const auto& effector : effectors_) {
+        count += effector->Inspect().GetElidedLayerCount();
+    }
+    return count;
+}
+
 void Trilobyte::AdjustVelocity(double adjustment)
 {
     SetVelocity(GetVelocity() + adjustment);
@@ -75,10 +88,48 @@ void Trilobyte::AdjustBearing(double adjustment)
 
 void Trilobyte::TickImpl(EntityContainerInterface& container, const UniverseParameters& universeParameters)
 {
+    GatherNeighbours(container, universeParameters);
+    TickSenses(universeParameters);
+    Think(universeParameters);
+    Act(container, universeParameters);
+}
+
+void Trilobyte::GatherNeighbours(EntityContainerInterface& container, const UniverseParameters& universeParameters)
+{
+    // Releasing a dead ancestor can change its ancestors, so isn't left to Act
     if (closestLivingAncestor_ && !closestLivingAncestor_->Exists()) {
         closestLivingAncestor_ = FindClosestLivingAncestor();
     }
 
+    if (health_ > 0.0) {
+        // Our senses and effectors all search around us, so only search the container once
+        neighbourhood_.emplace(container, Circle{ GetTransform().x, GetTransform().y, GetNeighbourhoodRadius() }, neighbours_, universeParameters);
+    }
+}
+
+void Trilobyte::TickSenses(const UniverseParameters& universeParameters)
+{
+    if (neighbourhood_ && brain_ && brain_->GetInputCount() > 0) {
+        std::fill(std::begin(brainValues_), std::end(brainValues_), 0.0);
+        for (auto& sense : senses_) {
+            sense->Tick(brainValues_, *neighbourhood_, universeParameters);
+        }
+    }
+}
+
+void Trilobyte::Think(const UniverseParameters& universeParameters)
+{
+    if (neighbourhood_ && brain_ && brain_->GetInputCount() > 0) {
+        if (universeParameters.memoiseBrainEvaluation_) {
+            brain_->ForwardPropogate(brainValues_, brainMemo_, universeParameters.brainMemoEpsilon_);
+        } else {
+            brain_->ForwardPropogate(brainValues_);
+        }
+    }
+}
+
+void Trilobyte::Act(EntityContainerInterface& container, const UniverseParameters& universeParameters)
+{
     if (health_ <= 0.0) {
         // explode into some chunks of meat
         const Energy TrilobyteEnergy = GetEnergy();
@@ -99,17 +150,13 @@ void Trilobyte::TickImpl(EntityContainerInterface& container, const UniversePara
         }
         Terminate();
     } else {
+        assert(neighbourhood_);
+        Neighbourhood& neighbourhood = *neighbourhood_;
+
         Energy energyUsed = 0_j;
         if (brain_ && brain_->GetInputCount() > 0) {
-            std::fill(std::begin(brainValues_), std::end(brainValues_), 0.0);
-            for (auto& sense : senses_) {
-                sense->Tick(brainValues_, container, universeParameters);
-            }
-
-            brain_->ForwardPropogate(brainValues_);
-
             for (auto& effector : effectors_) {
-                energyUsed += effector->Tick(brainValues_, container, universeParameters);
+                energyUsed += effector->Tick(brainValues_, neighbourhood, universeParameters);
             }
         }
 
@@ -124,12 +171,12 @@ void Trilobyte::TickImpl(EntityContainerInterface& container, const UniversePara
         UseEnergy(baseMetabolism_ + energyUsed);
 
         std::shared_ptr<Genome> otherGenes;
-        container.ForEachCollidingWith(Circle{ GetTransform().x, GetTransform().y, GetRadius() }, [&](const std::shared_ptr<Entity>& other) -> void
+        neighbourhood.ForEachContact(*this, [&](const std::shared_ptr<Entity>& other) -> void
         {
-            if (other.get() != this) {
-                if (Trilobyte* s = dynamic_cast<Trilobyte*>(other.get())) {
-                    otherGenes = s->genome_;
-                }
+            if (other->IsPassive()) {
+                other->OnContact(*this);
+            } else if (other->GetType() == EntityType::Trilobyte) {
+                otherGenes = static_cast<Trilobyte*>(other.get())->genome_;
             }
         });
 
@@ -139,6 +186,7 @@ void Trilobyte::TickImpl(EntityContainerInterface& container, const UniversePara
             Terminate();
         }
     }
+    neighbourhood_.reset();
 }
 
 void Trilobyte::DrawExtras(QPainter& paint, const DrawSettings& options)
@@ -163,7 +211,7 @@ void Trilobyte::DrawExtras(QPainter& paint, const DrawSettings& options)
 }
 
 Trilobyte::Trilobyte(Energy energy, const Transform& transform, std::shared_ptr<Genome> genome, const Phenotype& phenotype, std::shared_ptr<Trilobyte>&& mother)
-    : Entity(transform, 6.0, phenotype.colour, energy)
+    : Entity(EntityType::Trilobyte, transform, 6.0, phenotype.colour, energy)
     , closestLivingAncestor_(std::move(mother))
     , generation_(closestLivingAncestor_ ? closestLivingAncestor_->generation_ + 1 : 0)
     , baseMetabolism_(phenotype.baseMetabolism)
@@ -303,6 +351,20 @@ std::shared_ptr<Trilobyte> Trilobyte::FindClosestLivingAncestor() const
     return ancestor;
 }
 
+double Trilobyte::GetNeighbourhoodRadius() const
+{
+    double radius = 0.0;
+    for (const auto& sense : senses_) {
+        if (sense->IsActive()) {
+            radius = std::max(radius, sense->GetReach());
+        }
+    }
+    for (const auto& effector : effectors_) {
+        radius = std::max(radius, effector->GetReach());
+    }
+    return radius;
+}
+
 void Trilobyte::DescendantBorn(unsigned generation)
 {
     // record generations of descendants relative to this's generation
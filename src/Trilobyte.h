@@ -2,6 +2,7 @@
 #define SWIMMER_H
 
 #include "Entity.h"
+#include "Neighbourhood.h"
 #include "Genome/Genome.h"
 #include "Sensors/Sense.h"
 #include "Effectors/Effector.h"
@@ -9,8 +10,9 @@
 #include <NeuralNetwork.h>
 
 #include <memory>
+#include <optional>
 
-class Trilobyte : public Entity, public std::enable_shared_from_this<Trilobyte> {
+class Trilobyte final : public Entity, public std::enable_shared_from_this<Trilobyte> {
 public:
     Trilobyte(Energy energy, const Transform& transform, std::shared_ptr<Genome> genome);
     Trilobyte(Energy energy, const Transform& transform, std::shared_ptr<Genome> genome, std::shared_ptr<Trilobyte>&& parent);
@@ -28,7 +30,8 @@ public:
 
     uint64_t GetGeneration() const { return generation_; }
     const Energy& GetBaseMetabolism() const { return baseMetabolism_; }
-    double GetHealth() const { return health_; }
+    virtual double GetHealth() const override { return health_; }
+    virtual bool IsSelfPropelled() const override { return true; }
     unsigned GetEggsLayedCount() const { return eggsLayed_; }
     unsigned GetTotalDescendantsCount(unsigned generation) const { return totalDescentantCounts_.count(generation) ? totalDescentantCounts_.at(generation) : 0; }
     unsigned GetLivingDescendantsCount(unsigned generation) const { return extantDescentantCounts_.count(generation) ? extantDescentantCounts_.at(generation) : 0; }
@@ -36,12 +39,28 @@ public:
     unsigned GetLivingDescendantsCount() const;
     uint64_t GetGeneMutationCount() const { return genome_->GetGeneMutationCount(); }
     uint64_t GetChromosomeMutationCount() const { return genome_->GetChromosomeMutationCount(); }
+    unsigned GetElidedLayerCount() const;
+    const NeuralNetwork::Memo& GetBrainMemo() const { return brainMemo_; }
 
 
     void AdjustVelocity(double adjustment);
     void AdjustBearing(double adjustment);
     void ApplyDamage(double damage) { health_ -= std::min(health_, damage); }
 
+    /**
+     * TickImpl, split into the phases of a tick, so that a container can run
+     * each phase for every Trilobyte before starting the next. TickSenses,
+     * Think and Act only change the Trilobyte itself, so can be run for many
+     * Trilobytes in parallel. Act makes any other changes via the container,
+     * which must defer them until every Trilobyte has acted. The neighbours
+     * gathered are kept until Act, so nothing may be added to or moved within
+     * the container in between.
+     */
+    void GatherNeighbours(EntityContainerInterface& container, const UniverseParameters& universeParameters);
+    void TickSenses(const UniverseParameters& universeParameters);
+    void Think(const UniverseParameters& universeParameters);
+    void Act(EntityContainerInterface& container, const UniverseParameters& universeParameters);
+
 protected:
     std::shared_ptr<Trilobyte> closestLivingAncestor_;
 
@@ -59,6 +78,10 @@ private:
     std::vector<std::shared_ptr<Sense>> senses_;
     std::vector<std::shared_ptr<Effector>> effectors_;
     std::vector<double> brainValues_;
+    NeighbourList neighbours_;
+    // Only exists between GatherNeighbours and Act
+    std::optional<Neighbourhood> neighbourhood_;
+    NeuralNetwork::Memo brainMemo_;
 
     unsigned eggsLayed_;
     // <relative generation (where children of this are gen 1), count>
@@ -70,6 +93,7 @@ private:
     virtual std::vector<Property> CollectProperties() const override;
 
     std::shared_ptr<Trilobyte> FindClosestLivingAncestor() const;
+    double GetNeighbourhoodRadius() const;
 
     void DescendantBorn(unsigned generation);
     void DescendantDied(unsigned generation);
@@ -4,15 +4,26 @@
 #include "FoodPellet.h"
 #include "Egg.h"
 #include "Spike.h"
+#include "MeatChunk.h"
 #include "MainWindow.h"
 #include "Genome/GeneFactory.h"
 #include <Random.h>
 
 #include <QVariant>
 
+#include <limits>
+
 Universe::Universe(Rect startingQuad)
     : rootNode_(startingQuad, 25, 5, Entity::MAX_RADIUS * 2)
+    , sleepingEntities_(Entity::MAX_RADIUS * 4)
 {
+    commands_.resize(threads_.GetThreadCount());
+    // A few tiles per thread, so that threads with quiet tiles can act more of them
+    while ((size_t{ 1 } << (2 * tileDepth_)) < threads_.GetThreadCount() * 4) {
+        ++tileDepth_;
+    }
+    BuildTickGraph();
+
     // TODO get rid of this default nonsense here
     spawners_.push_back(std::make_shared<Spawner>(*this,  1000, -1000, 900, 50, 1000, Spawner::Shape::Square, Spawner::Spawn::Spike));
     spawners_.push_back(std::make_shared<Spawner>(*this,  1000, -1000, 950, 4500, 1.15, Spawner::Shape::Circle, Spawner::Spawn::FoodPellet));
@@ -34,7 +45,7 @@ Universe::Universe(Rect startingQuad)
             double distance = std::sqrt(Random::Number(0.0, 1.0)) * spawner->GetRadius();
             double trilobyteX = spawner->GetX() + distance * std::cos(rotation);
             double trilobyteY = spawner->GetY() + distance * std::sin(rotation);
-            rootNode_.Insert(std::make_shared<Trilobyte>(300_mj, Transform{ trilobyteX, trilobyteY, Random::Bearing() }, GeneFactory::Get().GenerateDefaultGenome(NeuralNetwork::BRAIN_WIDTH)));
+            AddEntity(std::make_shared<Trilobyte>(300_mj, Transform{ trilobyteX, trilobyteY, Random::Bearing() }, GeneFactory::Get().GenerateDefaultGenome(NeuralNetwork::BRAIN_WIDTH)));
         }
     }
 }
@@ -47,100 +58,226 @@ void Universe::SetEntityTargetPerQuad(uint64_t target, uint64_t leeway)
 
 
 
-void Universe::ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action)
+void Universe::AddEntity(std::shared_ptr<Entity> entity)
+{
+    GetCommandBuffer().AddEntity(std::move(entity));
+    if (!tickInProgress_) {
+        ApplyCommands();
+    }
+}
+
+void Universe::FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency)
+{
+    GetCommandBuffer().FeedOn(eater, food, quantity, efficiency);
+    if (!tickInProgress_) {
+        ApplyCommands();
+    }
+}
+
+void Universe::Damage(Entity& victim, double damage)
+{
+    GetCommandBuffer().Damage(victim, damage);
+    if (!tickInProgress_) {
+        ApplyCommands();
+    }
+}
+
+void Universe::ApplyCommands()
 {
     TRACE_FUNC()
-    rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
+    CommandBuffer::Apply(commands_, [&](std::shared_ptr<Entity> entity)
+    {
+        entity->SetClock(tickIndex_);
+        entity->Publish();
+        if (params_.neighbourListSkin_ > 0.0) {
+            recentlyAdded_.emplace_back(tickIndex_, entity);
+        }
+        if (tickInProgress_) {
+            // Like inserting mid iteration, not visible until the tick is over
+            entering_.push_back(std::move(entity));
+        } else {
+            rootNode_.Insert(std::move(entity));
+        }
+    });
+}
+
+std::function<bool (const EntityTraitTotals&)> Universe::ContainsAnyOf(EntityTypeMask types)
+{
+    if (types == ALL_ENTITY_TYPES) {
+        return {};
+    }
+    return [types](const EntityTraitTotals& totals)
+    {
+        return (totals.types & types) != 0;
+    };
+}
+
+template <typename Shape, typename Action>
+void Universe::ForEachSleepingCollidingWith(const Shape& collide, const Action& action, EntityTypeMask types) const
+{
+    TRACE_FUNC()
+    sleepingEntities_.ForEachItem(BoundingRect(collide, Entity::MAX_RADIUS), [&](const std::shared_ptr<Entity>& item)
+    {
+        if ((item->GetTypeMask() & types) && Collides(collide, item->GetCollide())) {
+            action(item);
+        }
+    }, ContainsAnyOf(types));
+}
+
+void Universe::ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    TRACE_FUNC()
+    rootNode_.ForEachItemNoRebalance(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
     {
         TRACE_LAMBDA("Entity->Action")
-        if (Collides(collide, item->GetCollide())) {
+        if ((item->GetTypeMask() & types) && Collides(collide, item->GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, action, types);
 }
 
-void Universe::ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action)
+void Universe::ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
 {
     TRACE_FUNC()
-    rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
+    rootNode_.ForEachItemNoRebalance(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
     {
         TRACE_LAMBDA("Entity->Action")
-        if (Collides(collide, item->GetCollide())) {
+        if ((item->GetTypeMask() & types) && Collides(collide, item->GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, action, types);
 }
 
-void Universe::ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action)
+void Universe::ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
 {
     TRACE_FUNC()
-    rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
+    rootNode_.ForEachItemNoRebalance(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
     {
         TRACE_LAMBDA("Entity->Action")
-        if (Collides(collide, item->GetCollide())) {
+        if ((item->GetTypeMask() & types) && Collides(collide, item->GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, action, types);
 }
 
-void Universe::ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action)
+void Universe::ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
 {
     TRACE_FUNC()
-    rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
+    rootNode_.ForEachItemNoRebalance(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> item)
     {
         TRACE_LAMBDA("Entity->Action")
-        if (Collides(collide, item->GetCollide())) {
+        if ((item->GetTypeMask() & types) && Collides(collide, item->GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, action, types);
 }
 
-void Universe::ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action) const
+void Universe::ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
 {
     TRACE_FUNC()
     rootNode_.ForEachItem(Tril::ConstQuadTreeIterator<Entity>([&](const Entity& item)
     {
         TRACE_LAMBDA("Entity.Action")
-        if (Collides(collide, item.GetCollide())) {
+        if ((item.GetTypeMask() & types) && Collides(collide, item.GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, [&](const std::shared_ptr<Entity>& item)
+    {
+        action(*item);
+    }, types);
 }
 
-void Universe::ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action) const
+void Universe::ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
 {
     TRACE_FUNC()
     rootNode_.ForEachItem(Tril::ConstQuadTreeIterator<Entity>([&](const Entity& item)
     {
         TRACE_LAMBDA("Entity.Action")
-        if (Collides(collide, item.GetCollide())) {
+        if ((item.GetTypeMask() & types) && Collides(collide, item.GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, [&](const std::shared_ptr<Entity>& item)
+    {
+        action(*item);
+    }, types);
 }
 
-void Universe::ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action) const
+void Universe::ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
 {
     TRACE_FUNC()
     rootNode_.ForEachItem(Tril::ConstQuadTreeIterator<Entity>([&](const Entity& item)
     {
         TRACE_LAMBDA("Entity.Action")
-        if (Collides(collide, item.GetCollide())) {
+        if ((item.GetTypeMask() & types) && Collides(collide, item.GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, [&](const std::shared_ptr<Entity>& item)
+    {
+        action(*item);
+    }, types);
 }
 
-void Universe::ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action) const
+void Universe::ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types) const
 {
     TRACE_FUNC()
     rootNode_.ForEachItem(Tril::ConstQuadTreeIterator<Entity>([&](const Entity& item)
     {
         TRACE_LAMBDA("Entity.Action")
-        if (Collides(collide, item.GetCollide())) {
+        if ((item.GetTypeMask() & types) && Collides(collide, item.GetCollide())) {
             action(item);
         }
-    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide));
+    }).SetQuadFilter(BoundingRect(collide, Entity::MAX_RADIUS)).SetItemFilter(collide), ContainsAnyOf(types));
+    ForEachSleepingCollidingWith(collide, [&](const std::shared_ptr<Entity>& item)
+    {
+        action(*item);
+    }, types);
+}
+
+void Universe::ForEachTotalWithin(const Circle& area, const std::function<void (const Rect&, const EntityTraitTotals&)>& totalAction, const std::function<void (const Entity&)>& action) const
+{
+    TRACE_FUNC()
+    rootNode_.ForEachAggregateOrItem(area, totalAction, action);
+    sleepingEntities_.ForEachAggregateOrItem(area, totalAction, action);
+}
+
+void Universe::ForEachContact(const Entity& entity, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types)
+{
+    TRACE_FUNC()
+    if (auto iter = contactIndices_.find(&entity); iter != contactIndices_.end()) {
+        contacts_.ForEachOverlapping(iter->second, [&](uint32_t other)
+        {
+            const auto& contact = contactEntities_[other];
+            if (contact->GetTypeMask() & types) {
+                action(contact);
+            }
+        });
+    } else {
+        // Not in the Universe at the start of the tick
+        ForEachCollidingWith(entity.GetCollide(), [&](const std::shared_ptr<Entity>& other)
+        {
+            if (other.get() != &entity) {
+                action(other);
+            }
+        }, types);
+    }
+}
+
+void Universe::ForEachAddedSince(uint64_t tick, const std::function<void (const std::shared_ptr<Entity>&)>& action) const
+{
+    TRACE_FUNC()
+    for (const auto& [ tickAdded, entity ] : recentlyAdded_) {
+        // Entities added during this tick won't be found until the next one
+        if (tickAdded >= tick && tickAdded < tickIndex_) {
+            action(entity);
+        }
+    }
 }
 
 std::shared_ptr<Entity> Universe::PickEntity(const Point& location, bool remove)
@@ -157,6 +294,23 @@ std::shared_ptr<Entity> Universe::PickEntity(const Point& location, bool remove)
     {
         return remove && picked && picked.get() == &entity;
     }));
+    if (!picked) {
+        ForEachSleepingCollidingWith(location, [&](const std::shared_ptr<Entity>& entity)
+        {
+            if (!picked) {
+                picked = entity;
+            }
+        }, ALL_ENTITY_TYPES);
+        if (remove && picked) {
+            sleepingEntities_.RemoveIf([&](const Entity& entity)
+            {
+                return picked.get() == &entity;
+            });
+        }
+    }
+    if (remove && picked) {
+        InvalidateNeighbourLists();
+    }
     return picked;
 }
 
@@ -208,11 +362,16 @@ void Universe::Draw(QPainter& p, const DrawSettings& options, const Rect& drawAr
         TRACE_LAMBDA("EntityDraw")
         entity->Draw(p, options);
     }).SetQuadFilter(BoundingRect(drawArea, Entity::MAX_RADIUS)));
+    sleepingEntities_.ForEachItem(BoundingRect(drawArea, Entity::MAX_RADIUS), [&](const std::shared_ptr<Entity>& entity)
+    {
+        TRACE_LAMBDA("EntityDraw")
+        entity->Draw(p, options);
+    });
 }
 
 std::vector<Property> Universe::GetProperties() const
 {
-    return {
+    std::vector<Property> properties{
         Property{
             "Ticks",
             [&]() -> std::string
@@ -228,13 +387,35 @@ std::vector<Property> Universe::GetProperties() const
             "Entities",
             [&]() -> std::string
             {
-                return std::to_string(rootNode_.Size());
+                return std::to_string(rootNode_.Size() + sleepingEntities_.Size());
             },
             "The total number of Entities that currently exist within the "
             "simulation. Individual entities can be selected for further "
             "information on them, it will appear as additional tabs in this "
             "view.",
         },
+        Property{
+            "Sleeping Entities",
+            [&]() -> std::string
+            {
+                return std::to_string(sleepingEntities_.Size());
+            },
+            "The number of Entities that are at rest and don't need to be "
+            "processed each tick, e.g. FoodPellets, Spikes and unhatched Eggs. "
+            "These are kept apart from the moving Entities, in a structure that "
+            "is quicker to search, and is only rebuilt when Entities are added "
+            "or removed.",
+        },
+        Property{
+            "Dormant Entities",
+            [&]() -> std::string
+            {
+                return std::to_string(wakeTimers_.Size());
+            },
+            "The number of sleeping Entities waiting to be woken at a later "
+            "tick, e.g. Eggs waiting to hatch. Dormant Entities are not "
+            "processed at all until they are due to wake.",
+        },
         Property{
             "Lunar Cycle",
             [&]() -> std::string
@@ -245,33 +426,419 @@ std::vector<Property> Universe::GetProperties() const
             "can be detected by Trilobytes giving them a shared external value "
             "that they can use to synchronise behaviour",
         },
+        Property{
+            "Contacts",
+            [&]() -> std::string
+            {
+                return std::to_string(contacts_.PairCount());
+            },
+            "The number of pairs of Entities whose bodies were overlapping at "
+            "the start of the current tick. Contacts are found all at once, so "
+            "that Entities reacting to whatever they are touching don't each "
+            "need to search for them.",
+        },
+        Property{
+            "Elided Layers",
+            [&]() -> std::string
+            {
+                unsigned elided = 0;
+                ForEach([&](const Entity& e)
+                {
+                    if (const Trilobyte* trilobyte = dynamic_cast<const Trilobyte*>(&e)) {
+                        elided += trilobyte->GetElidedLayerCount();
+                    }
+                });
+                return std::to_string(elided);
+            },
+            "The total number of neural network layers, across all living "
+            "Trilobytes, that are identity layers (each node passes its input "
+            "straight through). These layers are skipped when the network is "
+            "evaluated, only the sigma function is applied.",
+        },
+        Property{
+            "Brain Memo Hit Rate",
+            [&]() -> std::string
+            {
+                uint64_t hits = 0;
+                uint64_t misses = 0;
+                ForEach([&](const Entity& e)
+                {
+                    if (const Trilobyte* trilobyte = dynamic_cast<const Trilobyte*>(&e)) {
+                        hits += trilobyte->GetBrainMemo().hits_;
+                        misses += trilobyte->GetBrainMemo().misses_;
+                    }
+                });
+                if (hits + misses == 0) {
+                    return "N/A";
+                }
+                return fmt::format("{:.1f}%", (100.0 * hits) / (hits + misses));
+            },
+            "When brain memoisation is enabled, the percentage of brain "
+            "evaluations, across all living Trilobytes, that were skipped "
+            "because the brain's inputs had not changed since the previous tick.",
+        },
+        Property{
+            "Tiles",
+            [&]() -> std::string
+            {
+                size_t busiest = 0;
+                for (const Tile& tile : tiles_) {
+                    busiest = std::max(busiest, tile.end - tile.begin);
+                }
+                return fmt::format("{} (busiest has {} Trilobytes)", tiles_.size(), busiest);
+            },
+            "The number of areas the simulation is split into, so that the "
+            "Trilobytes in each area can act at the same time as those in "
+            "other areas, on separate threads. Trilobytes that cross into "
+            "another area are moved between them at the end of each tick.",
+        },
     };
+
+    for (Tril::TaskGraph::TaskId phase = 0; phase < tickGraph_.Size(); ++phase) {
+        properties.push_back(Property{
+            "Tick Phase: " + tickGraph_.GetName(phase),
+            [&, phase]() -> std::string
+            {
+                return fmt::format("{:.3f}ms", std::chrono::duration<double, std::milli>(tickGraph_.GetDuration(phase)).count());
+            },
+            "How long this phase of the last tick took. Phases that don't "
+            "depend on one another run at the same time, on separate threads.",
+        });
+    }
+
+    return properties;
+}
+
+template <typename T>
+void Universe::TickEntity(T& entity, double& maxDisplacementSquare)
+{
+    if (entity.IsPassive()) {
+        // Acted upon by the entities that touch it instead
+        return;
+    } else if (entity.IsDormant() && entity.IsAtRest()) {
+        // Will be ticked once it wakes
+        return;
+    } else if constexpr (std::is_same_v<T, Entity>) {
+        Point before = entity.GetLocation();
+        entity.Tick(*this, params_);
+        RecordDisplacement(GetDistanceSquare(before, entity.GetLocation()), maxDisplacementSquare);
+    } else {
+        // Moved afterwards, along with the rest, see MoveAll
+        entity.template TickAs<T>(*this, params_);
+    }
+}
+
+template <typename T>
+void Universe::TickAll(EntityType type, uint64_t& issuer, double& maxDisplacementSquare)
+{
+    TRACE_FUNC()
+    for (const auto& entity : entitiesByType_[static_cast<size_t>(type)]) {
+        Random::Stream random(tickIndex_, RandomStream::Act, issuer);
+        GetCommandBuffer().SetIssuer(issuer++);
+        TickEntity(static_cast<T&>(*entity), maxDisplacementSquare);
+    }
+}
+
+void Universe::MoveAll(std::initializer_list<EntityType> types, double& maxDisplacementSquare)
+{
+    TRACE_FUNC()
+    movement_.Clear();
+    for (EntityType type : types) {
+        for (const auto& entity : entitiesByType_[static_cast<size_t>(type)]) {
+            movement_.Add(entity->GetLocation(), entity->GetHeading(), entity->GetVelocity());
+        }
+    }
+
+    movement_.Step(Entity::MIN_SPEED, Entity::SPEED_RETAINED_PER_TICK);
+
+    size_t index = 0;
+    for (EntityType type : types) {
+        for (const auto& entity : entitiesByType_[static_cast<size_t>(type)]) {
+            if (movement_.Moved(index)) {
+                entity->SetMovement(movement_.GetLocation(index), movement_.GetSpeed(index));
+            }
+            ++index;
+        }
+    }
+    RecordDisplacement(movement_.GetMaxDisplacementSquare(), maxDisplacementSquare);
+}
+
+void Universe::RecordDisplacement(double displacementSquare, double& maxDisplacementSquare)
+{
+    if (params_.neighbourListSkin_ > 0.0 && displacementSquare > maxDisplacementSquare) {
+        params_.totalMaxDisplacement_ += std::sqrt(displacementSquare) - std::sqrt(maxDisplacementSquare);
+        maxDisplacementSquare = displacementSquare;
+    }
+}
+
+bool Universe::CanSleep(const Entity& entity)
+{
+    return entity.Exists() && !entity.IsSelfPropelled() && entity.IsAtRest() && (entity.IsPassive() || entity.IsDormant());
+}
+
+void Universe::BuildTickGraph()
+{
+    /*
+     * Each phase starts as soon as the phases it depends on have finished, so
+     * the searchable structures rebuilt at the start of the tick are all
+     * updated alongside one another. The spawners are ticked alongside the
+     * Trilobytes thinking and acting, but only once the neighbour lists from
+     * the last tick, which may hold the last reference to an entity, have been
+     * replaced, so that entities are only destroyed while no spawner is
+     * counting them. Each type of entity is ticked in its own loop, so that
+     * each loop only runs the code of a single type. FoodPellets and Spikes
+     * are passive so are never ticked. Every Trilobyte senses, then every
+     * Trilobyte thinks, which each only change the Trilobyte itself, so are
+     * spread across every thread. Then every Trilobyte acts, followed by every
+     * Egg and every MeatChunk.
+     *
+     * Trilobytes act tile by tile, each tile being one of the quads near the
+     * top of rootNode_, with each tile acted by a single thread. A Trilobyte
+     * only reads the entities within reach of it, so each tile only reads a
+     * halo around itself, as wide as the furthest reaching sense or effector.
+     * No tile writes to its halo, as changes to other entities are deferred
+     * until every tile is done, so tiles are acted without any locking. Each
+     * entity belongs to the tile whose area it is in, so entities that cross
+     * into another tile change owner once rootNode_ is updated.
+     *
+     * Everything ticked on the thread pool draws random numbers from a
+     * Random::Stream keyed on the tick and on what is being ticked, so a
+     * seeded run is the same no matter which thread ticks what.
+     *
+     * Entities added part way through the tick, including any woken, aren't
+     * ticked or found by queries until the next tick. None of the ticked
+     * entities move or publish their other changes until they have all been
+     * ticked, so each sees the others as they were at the start of the tick,
+     * see Entity::GetTraits. Changes to other entities, and new entities, are
+     * applied in tick order, after the spawners' new entities.
+     *
+     * The per tick tasks aren't part of the graph, they are run on the thread
+     * that called Tick, once the graph is done, see Tick.
+     */
+    using TaskId = Tril::TaskGraph::TaskId;
+    TaskId prepare = tickGraph_.Add("Prepare", [&]() { PrepareTick(); });
+    TaskId aggregates = tickGraph_.Add("Aggregates", [&]() { rootNode_.UpdateAggregates(); }, { prepare });
+    TaskId sleepingAggregates = tickGraph_.Add("Sleeping Aggregates", [&]() { sleepingEntities_.UpdateAggregates(); }, { prepare });
+    TaskId contacts = tickGraph_.Add("Contacts", [&]() { UpdateContacts(); }, { prepare });
+    TaskId gather = tickGraph_.Add("Gather", [&]() { GatherEntitiesByType(); }, { prepare });
+    TaskId sense = tickGraph_.Add("Sense", [&]() { SenseAll(); }, { aggregates, sleepingAggregates, contacts, gather });
+    TaskId think = tickGraph_.Add("Think", [&]() { ThinkAll(); }, { sense });
+    TaskId act = tickGraph_.Add("Act", [&]() { ActAll(); }, { think });
+    // Sense releases the last references to entities removed last tick
+    TaskId spawn = tickGraph_.Add("Spawn", [&]() { TickSpawners(); }, { sense });
+    TaskId commands = tickGraph_.Add("Commands", [&]() { ApplyCommands(); }, { act, spawn });
+    TaskId move = tickGraph_.Add("Move", [&]() { MoveAll({ EntityType::Trilobyte, EntityType::Egg, EntityType::MeatChunk }, maxDisplacementSquare_); }, { commands });
+    TaskId index = tickGraph_.Add("Index", [&]() { UpdateIndex(); }, { move });
+    tickGraph_.Add("Finish", [&]() { FinishTick(); }, { index });
 }
 
 void Universe::Tick()
 {
     TRACE_FUNC()
+    tickGraph_.Run(threads_);
+    // On the calling thread, as tasks may update the GUI
+    perTickTasks_.ForEach([=](auto& task) -> void
+    {
+        std::invoke(task, tickIndex_);
+    });
+    ++tickIndex_;
+}
+
+void Universe::PrepareTick()
+{
     params_.lunarCycle_ = GetLunarCycle();
+    params_.globalSenseOutputs_.clear();
+    params_.tick_ = tickIndex_;
 
-    rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> entity)
+    if (params_.neighbourListSkin_ > 0.0) {
+        while (!recentlyAdded_.empty() && recentlyAdded_.front().first + params_.neighbourListMaxAge_ < tickIndex_) {
+            recentlyAdded_.pop_front();
+        }
+    } else {
+        recentlyAdded_.clear();
+        // Entities added while disabled won't have been recorded
+        params_.neighbourListsValidFrom_ = tickIndex_ + 1;
+    }
+
+    maxDisplacementSquare_ = 0.0;
+    nextIssuer_ = 0;
+    tickInProgress_ = true;
+}
+
+void Universe::GatherEntitiesByType()
+{
+    TRACE_FUNC()
+    for (auto& entities : entitiesByType_) {
+        entities.clear();
+    }
+    tiles_.clear();
+    // Gathered tile by tile, so the Trilobytes of each tile are consecutive
+    const auto& trilobytes = entitiesByType_[static_cast<size_t>(EntityType::Trilobyte)];
+    rootNode_.ForEachTile(tileDepth_, [&](const Rect& tileArea)
     {
-        TRACE_LAMBDA("EntityTick")
-        entity->Tick(*this, params_);
-    }).SetRemoveItemPredicate([](const Entity& entity)
+        tiles_.push_back({ tileArea, trilobytes.size(), trilobytes.size() });
+    }, [&](const std::shared_ptr<Entity>& entity)
     {
-        return !entity.Exists();
-    }));
+        entitiesByType_[static_cast<size_t>(entity->GetType())].push_back(entity);
+        tiles_.back().end = trilobytes.size();
+    });
+}
 
+void Universe::SenseAll()
+{
+    TRACE_FUNC()
+    const auto& trilobytes = entitiesByType_[static_cast<size_t>(EntityType::Trilobyte)];
+    // Gathering may release the last reference to an entity, so isn't parallel
+    for (const auto& trilobyte : trilobytes) {
+        static_cast<Trilobyte&>(*trilobyte).GatherNeighbours(*this, params_);
+    }
+    threads_.ParallelFor(0, trilobytes.size(), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) {
+            // Keyed as the Trilobyte's issuer will be when it acts
+            Random::Stream random(tickIndex_, RandomStream::Sense, i);
+            static_cast<Trilobyte&>(*trilobytes[i]).TickSenses(params_);
+        }
+    });
+}
+
+void Universe::ThinkAll()
+{
+    TRACE_FUNC()
+    const auto& trilobytes = entitiesByType_[static_cast<size_t>(EntityType::Trilobyte)];
+    threads_.ParallelFor(0, trilobytes.size(), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) {
+            static_cast<Trilobyte&>(*trilobytes[i]).Think(params_);
+        }
+    });
+}
+
+void Universe::ActAll()
+{
+    TRACE_FUNC()
+    const auto& trilobytes = entitiesByType_[static_cast<size_t>(EntityType::Trilobyte)];
+    threads_.ParallelFor(0, tiles_.size(), 1, [&](size_t begin, size_t end)
+    {
+        TRACE_LAMBDA("ActTiles")
+        for (size_t tile = begin; tile < end; ++tile) {
+            for (size_t i = tiles_[tile].begin; i < tiles_[tile].end; ++i) {
+                // The same issuers, and random numbers, as if every tile were acted in turn
+                Random::Stream random(tickIndex_, RandomStream::Act, nextIssuer_ + i);
+                GetCommandBuffer().SetIssuer(nextIssuer_ + i);
+                static_cast<Trilobyte&>(*trilobytes[i]).Act(*this, params_);
+            }
+        }
+    });
+    nextIssuer_ += trilobytes.size();
+    // Hatching changes the new Trilobyte's ancestors, wherever they are, so Eggs aren't split into tiles
+    TickAll<Egg>(EntityType::Egg, nextIssuer_, maxDisplacementSquare_);
+    TickAll<MeatChunk>(EntityType::MeatChunk, nextIssuer_, maxDisplacementSquare_);
+}
+
+void Universe::TickSpawners()
+{
+    TRACE_FUNC()
+    // After every entity, and the same random numbers, no matter which thread this runs on
+    Random::Stream random(tickIndex_, RandomStream::Spawn);
+    GetCommandBuffer().SetIssuer(std::numeric_limits<uint64_t>::max());
     for (auto& spawner : spawners_) {
         spawner->Tick(params_);
     }
+}
 
-    perTickTasks_.ForEach([=](auto& task) -> void
+void Universe::UpdateIndex()
+{
+    TRACE_FUNC()
+    fallingAsleep_.clear();
+    for (auto& entities : entitiesByType_) {
+        for (auto& entity : entities) {
+            entity->Publish();
+            if (CanSleep(*entity)) {
+                fallingAsleep_.push_back(std::move(entity));
+            }
+        }
+        // Keeps the capacity for the next tick, without keeping the entities alive
+        entities.clear();
+    }
+    rootNode_.Update([&](const Entity& entity)
     {
-        std::invoke(task, tickIndex_);
+        return !entity.Exists() || CanSleep(entity);
     });
 
-    ++tickIndex_;
+    // Sleeping entities are only ticked when a dormant one is due to wake
+    wakeTimers_.Advance(tickIndex_, [&](const std::weak_ptr<Entity>& dormant)
+    {
+        TRACE_LAMBDA("DormantEntityTick")
+        std::shared_ptr<Entity> entity = dormant.lock();
+        // Any that were woken some other way have already been ticked
+        if (entity && entity->Exists() && sleepingEntities_.Includes(*entity)) {
+            Random::Stream random(tickIndex_, RandomStream::Act, nextIssuer_);
+            GetCommandBuffer().SetIssuer(nextIssuer_++);
+            TickEntity(*entity, maxDisplacementSquare_);
+            if (entity->Exists() && !CanSleep(*entity)) {
+                // Moving, or needs ticking every tick, so joins the rest in rootNode_
+                entering_.push_back(entity);
+            } else if (entity->Exists() && entity->IsDormant()) {
+                ScheduleWake(entity);
+            }
+        }
+    });
+
+    for (auto& entity : fallingAsleep_) {
+        if (!entity->IsPassive()) {
+            ScheduleWake(entity);
+        }
+        sleepingEntities_.Insert(std::move(entity));
+    }
+    fallingAsleep_.clear();
+    sleepingEntities_.RemoveIf([&](const Entity& entity)
+    {
+        return !CanSleep(entity);
+    });
+}
+
+void Universe::FinishTick()
+{
+    ApplyCommands();
+    tickInProgress_ = false;
+    rootNode_.Insert(std::move(entering_));
+    entering_.clear();
+    // Otherwise removed entities would outlive the tick they were removed in
+    contactEntities_.clear();
+    contactIndices_.clear();
+}
+
+void Universe::InvalidateNeighbourLists()
+{
+    // Lists may contain entities that are no longer in the universe
+    params_.neighbourListsValidFrom_ = tickIndex_;
+}
+
+void Universe::ScheduleWake(const std::shared_ptr<Entity>& entity)
+{
+    wakeTimers_.Schedule(tickIndex_ + (entity->GetWakeAge() - entity->GetAge()), entity);
+}
+
+void Universe::UpdateContacts()
+{
+    TRACE_FUNC()
+    contacts_.Clear();
+    contactEntities_.clear();
+    contactIndices_.clear();
+    rootNode_.ForEachItemNoRebalance(Tril::QuadTreeIterator<Entity>([&](std::shared_ptr<Entity> entity)
+    {
+        contactIndices_.emplace(entity.get(), static_cast<uint32_t>(contactEntities_.size()));
+        contacts_.Add(entity->GetCollide());
+        contactEntities_.push_back(std::move(entity));
+    }));
+    sleepingEntities_.ForEachItem([&](const std::shared_ptr<Entity>& entity)
+    {
+        contactIndices_.emplace(entity.get(), static_cast<uint32_t>(contactEntities_.size()));
+        contacts_.Add(entity->GetCollide());
+        contactEntities_.push_back(entity);
+    });
+    contacts_.Update();
 }
 
 double Universe::GetLunarCycle() const
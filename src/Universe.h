@@ -8,10 +8,17 @@
 #include "EntityContainerInterface.h"
 #include "UniverseParameters.h"
 #include "PropertyTableModel.h"
+#include "CommandBuffer.h"
 
 #include <Energy.h>
 #include <AutoClearingContainer.h>
 #include <QuadTree.h>
+#include <PackedGrid.h>
+#include <TimerWheel.h>
+#include <SweepAndPrune.h>
+#include <MotionBatch.h>
+#include <ThreadPool.h>
+#include <TaskGraph.h>
 #include <ChromeTracing.h>
 
 #include <QTimer>
@@ -19,6 +26,11 @@
 
 #include <iomanip>
 #include <functional>
+#include <array>
+#include <vector>
+#include <initializer_list>
+#include <deque>
+#include <unordered_map>
 #include <math.h>
 
 class Universe : public EntityContainerInterface {
@@ -27,36 +39,46 @@ public:
 
     void SetEntityTargetPerQuad(uint64_t target, uint64_t leeway);
 
-    void AddEntity(std::shared_ptr<Entity> entity) override { rootNode_.Insert(entity); }
-    void ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action) override final;
-    void ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action) override final;
-    void ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action) override final;
-    void ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action) override final;
-    void ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action) const override final;
-    void ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action) const override final;
-    void ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action) const override final;
-    void ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action) const override final;
+    void AddEntity(std::shared_ptr<Entity> entity) override;
+    void FeedOn(Entity& eater, Entity& food, Energy quantity, double efficiency = 1.0) override final;
+    void Damage(Entity& victim, double damage) override final;
+    void ForEachCollidingWith(const Point& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override final;
+    void ForEachCollidingWith(const Line& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override final;
+    void ForEachCollidingWith(const Rect& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override final;
+    void ForEachCollidingWith(const Circle& collide, const std::function<void (const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override final;
+    void ForEachCollidingWith(const Point& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override final;
+    void ForEachCollidingWith(const Line& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override final;
+    void ForEachCollidingWith(const Rect& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override final;
+    void ForEachCollidingWith(const Circle& collide, const std::function<void (const Entity&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) const override final;
+    void ForEachTotalWithin(const Circle& area, const std::function<void(const Rect& region, const EntityTraitTotals& total)>& totalAction, const std::function<void(const Entity&)>& action) const override final;
+    void ForEachContact(const Entity& entity, const std::function<void(const std::shared_ptr<Entity>&)>& action, EntityTypeMask types = ALL_ENTITY_TYPES) override final;
+    void ForEachAddedSince(uint64_t tick, const std::function<void(const std::shared_ptr<Entity>&)>& action) const override final;
 
     std::shared_ptr<Entity> PickEntity(const Point& location, bool remove);
-    void ClearAllEntities() { rootNode_.Clear(); }
+    void ClearAllEntities() { rootNode_.Clear(); sleepingEntities_.Clear(); wakeTimers_.Clear(); InvalidateNeighbourLists(); }
     template <typename... T>
     void ClearAllEntitiesOfType()
     {
         TRACE_FUNC()
-        rootNode_.RemoveIf([](const Entity& item) -> bool
+        InvalidateNeighbourLists();
+        auto isOfType = [](const Entity& item) -> bool
         {
             return (dynamic_cast<const T*>(&item) || ...);
-        });
+        };
+        rootNode_.RemoveIf(isOfType);
+        sleepingEntities_.RemoveIf(isOfType);
     }
     void ForEach(const std::function<void (const Entity& e)>& action) const
     {
         TRACE_FUNC()
         rootNode_.ForEachItem(Tril::ConstQuadTreeIterator<Entity>([=](const Entity& e){action(e);}));
+        sleepingEntities_.ForEachItem([&](const std::shared_ptr<Entity>& e){action(*e);});
     }
     void ForEach(const std::function<void (std::shared_ptr<Entity> e)>& action)
     {
         TRACE_FUNC()
         rootNode_.ForEachItem(Tril::QuadTreeIterator<Entity>([=](std::shared_ptr<Entity> e){action(e);}));
+        sleepingEntities_.ForEachItem([&](const std::shared_ptr<Entity>& e){action(e);});
     }
 
     void AddSpawner(const std::shared_ptr<Spawner>& spawner) { spawners_.push_back(spawner); }
@@ -85,15 +107,83 @@ public:
     std::vector<Property> GetProperties() const;
 
 private:
-    Tril::QuadTree<Entity> rootNode_;
+    Tril::QuadTree<Entity, EntityTraitTotals> rootNode_;
+    // Entities at rest that can't move by themselves, kept out of rootNode_
+    Tril::PackedGrid<Entity, EntityTraitTotals> sleepingEntities_;
+    // Sleeping entities that are dormant, by the tick they are due to wake
+    Tril::TimerWheel<std::weak_ptr<Entity>> wakeTimers_;
     std::vector<std::shared_ptr<Spawner>> spawners_;
     UniverseParameters params_;
+    // Every pair of overlapping entities, found once at the start of each tick, entities are only kept until the end of the tick
+    Tril::SweepAndPrune contacts_;
+    std::vector<std::shared_ptr<Entity>> contactEntities_;
+    std::unordered_map<const Entity*, uint32_t> contactIndices_;
+
+    // The entities in rootNode_ at the start of the tick, by EntityType
+    std::array<std::vector<std::shared_ptr<Entity>>, ENTITY_TYPE_COUNT> entitiesByType_;
+    // An area of rootNode_, whose Trilobytes are acted by a single thread
+    struct Tile {
+        Rect area;
+        // The range of entitiesByType_ holding the Trilobytes within area
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Tile> tiles_;
+    // Tiles are the quads this many levels below the root of rootNode_
+    size_t tileDepth_ = 0;
+    // The movement of every ticked entity, applied all at once
+    Tril::MotionBatch movement_;
+    // Changes requested by entities while they are being ticked, one buffer per thread
+    std::vector<CommandBuffer> commands_;
+    uint64_t nextIssuer_ = 0;
+    // Entities added (or woken) part way through a tick, inserted once it is over
+    std::vector<std::shared_ptr<Entity>> entering_;
+    bool tickInProgress_ = false;
+    // Kept up to date as entities move, so it is valid part way through a tick
+    double maxDisplacementSquare_ = 0.0;
+    std::vector<std::shared_ptr<Entity>> fallingAsleep_;
 
     uint64_t tickIndex_ = 0;
+    // Along with the tick and the issuer, keys the Random::Stream each entity draws from
+    enum class RandomStream : uint64_t { Sense, Act, Spawn };
+    // <tick added, entity> for the last UniverseParameters::neighbourListMaxAge_ ticks
+    std::deque<std::pair<uint64_t, std::shared_ptr<Entity>>> recentlyAdded_;
 
     Tril::AutoClearingContainer<std::function<void(uint64_t tick)>> perTickTasks_;
 
+    // The phases of each tick, run on threads_, see BuildTickGraph
+    Tril::ThreadPool threads_;
+    Tril::TaskGraph tickGraph_;
+
+    static bool CanSleep(const Entity& entity);
+
     double GetLunarCycle() const;
+    CommandBuffer& GetCommandBuffer() { return commands_[threads_.GetThreadIndex()]; }
+    void BuildTickGraph();
+    void PrepareTick();
+    void GatherEntitiesByType();
+    void SenseAll();
+    void ThinkAll();
+    void ActAll();
+    void TickSpawners();
+    void UpdateIndex();
+    void FinishTick();
+    void InvalidateNeighbourLists();
+    void ApplyCommands();
+    void UpdateContacts();
+    template <typename T>
+    void TickEntity(T& entity, double& maxDisplacementSquare);
+    template <typename T>
+    void TickAll(EntityType type, uint64_t& issuer, double& maxDisplacementSquare);
+    void MoveAll(std::initializer_list<EntityType> types, double& maxDisplacementSquare);
+    void RecordDisplacement(double displacementSquare, double& maxDisplacementSquare);
+    void ScheduleWake(const std::shared_ptr<Entity>& entity);
+
+    template <typename Shape, typename Action>
+    void ForEachSleepingCollidingWith(const Shape& collide, const Action& action, EntityTypeMask types) const;
+
+    // Skips the regions of rootNode_ that contain none of the specified types
+    static std::function<bool(const EntityTraitTotals& totals)> ContainsAnyOf(EntityTypeMask types);
 };
 
 #endif // UNIVERSE_H
@@ -1,6 +1,14 @@
 #ifndef UNIVERSEPARAMETERS_H
 #define UNIVERSEPARAMETERS_H
 
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+class NeuralNetwork;
+
 /**
  * @brief The UniverseParameters class is meant to allow the tick methods to
  * easily obtain an expandable selection of user controlled settings, without
@@ -32,6 +40,31 @@ public:
     double structuralMutationCountStdDev_ = 0.2;
     /// This adjusts the spawn rate for all food spawners
     double spawnRateModifier = 1.0;
+    /// When enabled, trilobytes whose brain inputs haven't changed (within the
+    /// epsilon) since the previous tick re-use the previous brain outputs
+    bool memoiseBrainEvaluation_ = false;
+    double brainMemoEpsilon_ = 0.0;
+    /// When greater than 0.0, each trilobyte gathers its neighbours from this
+    /// far beyond its reach, and re-uses them in later ticks until something
+    /// could have moved far enough to be missed, or the list has been kept for
+    /// the maximum age. See NeighbourList
+    double neighbourListSkin_ = 0.0;
+    uint64_t neighbourListMaxAge_ = 20;
+    /// Maintained by the Universe for neighbour lists. The index of the current
+    /// tick, the furthest any entity could have moved since the simulation
+    /// started, and the earliest tick a neighbour list can have been gathered
+    /// in and still be valid (entities removed from the Universe invalidate all
+    /// lists).
+    uint64_t tick_ = 0;
+    double totalMaxDisplacement_ = 0.0;
+    uint64_t neighbourListsValidFrom_ = 0;
+    /// Senses that only depend on values shared by the whole universe (see
+    /// Sense::IsGlobal) produce the same output for every owner sharing the
+    /// same network, so the first to tick each tick stores its output here for
+    /// the rest to copy. Cleared at the start of every tick. Senses may be
+    /// ticked in parallel, so the mutex must be held while using it.
+    mutable std::map<std::shared_ptr<const NeuralNetwork>, std::vector<double>> globalSenseOutputs_;
+    mutable std::mutex globalSenseOutputsMutex_;
 };
 
 #endif // UNIVERSEPARAMETERS_H
@@ -0,0 +1,72 @@
+#include <MotionBatch.h>
+#include <Random.h>
+#include <MathConstants.h>
+
+#include <catch2/catch.hpp>
+
+using namespace Tril;
+
+TEST_CASE("MotionBatch", "[container]")
+{
+    Random::Seed(42);
+
+    MotionBatch batch;
+
+    SECTION("Empty")
+    {
+        batch.Step(0.05, 0.9);
+        REQUIRE(batch.Size() == 0);
+        REQUIRE(batch.GetMaxDisplacementSquare() == 0.0);
+    }
+
+    SECTION("Slow objects don't move")
+    {
+        batch.Add({ 1.0, 2.0 }, Heading::FromBearing(1.0), 0.05);
+        batch.Add({ 3.0, 4.0 }, Heading::FromBearing(2.0), -0.01);
+        batch.Step(0.05, 0.9);
+        REQUIRE(!batch.Moved(0));
+        REQUIRE(!batch.Moved(1));
+        REQUIRE(batch.GetLocation(0).x == 1.0);
+        REQUIRE(batch.GetLocation(0).y == 2.0);
+        REQUIRE(batch.GetSpeed(0) == 0.05);
+        REQUIRE(batch.GetSpeed(1) == -0.01);
+        REQUIRE(batch.GetMaxDisplacementSquare() == 0.0);
+    }
+
+    SECTION("Matches moving one object at a time")
+    {
+        const Rect area{ -100, -100, 100, 100 };
+        std::vector<Point> locations;
+        std::vector<Heading> headings;
+        std::vector<double> speeds;
+        for (int i = 0; i < 1000; ++i) {
+            locations.push_back(Random::PointIn(area));
+            headings.push_back(Heading::FromBearing(Random::Number(0.0, Tau)));
+            speeds.push_back(Random::Number(-2.0, 2.0));
+            batch.Add(locations.back(), headings.back(), speeds.back());
+        }
+        batch.Step(0.05, 0.9);
+
+        double maxDisplacementSquare = 0.0;
+        for (size_t i = 0; i < locations.size(); ++i) {
+            bool moving = std::abs(speeds[i]) > 0.05;
+            Point expected = moving ? LocalOffset{ 0.0, speeds[i] }.ApplyTo(locations[i], headings[i]) : locations[i];
+            REQUIRE(batch.Moved(i) == moving);
+            REQUIRE(batch.GetLocation(i).x == expected.x);
+            REQUIRE(batch.GetLocation(i).y == expected.y);
+            REQUIRE(batch.GetSpeed(i) == (moving ? speeds[i] * 0.9 : speeds[i]));
+            maxDisplacementSquare = std::max(maxDisplacementSquare, GetDistanceSquare(locations[i], expected));
+        }
+        REQUIRE(batch.GetMaxDisplacementSquare() == Approx(maxDisplacementSquare));
+    }
+
+    SECTION("Clear")
+    {
+        batch.Add({ 0.0, 0.0 }, Heading::FromBearing(0.0), 1.0);
+        batch.Step(0.05, 0.9);
+        REQUIRE(batch.GetMaxDisplacementSquare() == Approx(1.0));
+        batch.Clear();
+        REQUIRE(batch.Size() == 0);
+        REQUIRE(batch.GetMaxDisplacementSquare() == 0.0);
+    }
+}
@@ -0,0 +1,205 @@
+#include <NeuralNetwork.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+std::vector<double> ReferenceForwardPropogate(const NeuralNetwork& network, std::vector<double> values)
+{
+    std::vector<std::vector<NeuralNetwork::Node>> layers;
+    network.ForEach([&](unsigned /*nodeIndex*/, unsigned layerIndex, const NeuralNetwork::Node& node)
+    {
+        layers.resize(layerIndex);
+        layers.at(layerIndex - 1).push_back(node);
+    });
+
+    for (const auto& layer : layers) {
+        std::vector<double> next;
+        for (const auto& node : layer) {
+            double nodeValue = 0.0;
+            for (size_t edge = 0; edge < node.size(); ++edge) {
+                nodeValue += node.at(edge) * values.at(edge);
+            }
+            next.push_back(std::tanh(nodeValue));
+        }
+        values = next;
+    }
+    return values;
+}
+
+void RequireSameOutputs(const NeuralNetwork& network)
+{
+    std::vector<double> inputs = Random::Numbers(network.GetInputCount(), -1.0, 1.0);
+    std::vector<double> expected = ReferenceForwardPropogate(network, inputs);
+    network.ForwardPropogate(inputs);
+
+    REQUIRE(inputs.size() == expected.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        REQUIRE_THAT(inputs.at(i), Catch::Matchers::WithinAbs(expected.at(i), 0.000001));
+    }
+}
+
+}
+
+TEST_CASE("NeuralNetwork", "[network]")
+{
+    Random::Seed(42);
+
+    SECTION("Identity layers are elided")
+    {
+        for (unsigned layerCount : { 0u, 1u, 3u }) {
+            NeuralNetwork passThrough(layerCount, 7, NeuralNetwork::InitialWeights::PassThrough);
+            REQUIRE(passThrough.GetElidedLayerCount() == layerCount);
+            RequireSameOutputs(passThrough);
+
+            NeuralNetwork random(layerCount, 7, NeuralNetwork::InitialWeights::Random);
+            REQUIRE(random.GetElidedLayerCount() == 0);
+            RequireSameOutputs(random);
+        }
+    }
+
+    SECTION("Mixed identity and weighted layers")
+    {
+        std::shared_ptr<NeuralNetwork> network = std::make_shared<NeuralNetwork>(2, 5, NeuralNetwork::InitialWeights::Random);
+        network = network->WithRowAdded(1, NeuralNetwork::InitialWeights::PassThrough);
+        network = network->WithRowAdded(0, NeuralNetwork::InitialWeights::PassThrough);
+        REQUIRE(network->GetLayerCount() == 4);
+        REQUIRE(network->GetElidedLayerCount() == 2);
+        RequireSameOutputs(*network);
+
+        for (unsigned i = 0; i < 100; ++i) {
+            network = network->WithMutatedConnections();
+            REQUIRE(network->GetElidedLayerCount() <= 2);
+            RequireSameOutputs(*network);
+            network = i % 2 ? network->WithRowAdded(i % 4, NeuralNetwork::InitialWeights::PassThrough) : network->WithRowRemoved(i % 4);
+            // Shared layers keep their parent's elision, which must match checking every layer again
+            std::vector<NeuralNetwork::Layer> layers(network->GetLayerCount());
+            network->ForEach([&](unsigned /*nodeIndex*/, unsigned layerIndex, const NeuralNetwork::Node& node)
+            {
+                layers.at(layerIndex - 1).push_back(node);
+            });
+            REQUIRE(network->GetElidedLayerCount() == NeuralNetwork(std::move(layers), 5).GetElidedLayerCount());
+            RequireSameOutputs(*network);
+        }
+    }
+
+    SECTION("Column changes")
+    {
+        std::shared_ptr<NeuralNetwork> network = std::make_shared<NeuralNetwork>(3, 4, NeuralNetwork::InitialWeights::PassThrough);
+        network = network->WithColumnAdded(2, NeuralNetwork::InitialWeights::PassThrough);
+        REQUIRE(network->GetInputCount() == 5);
+        RequireSameOutputs(*network);
+
+        network = network->WithColumnAdded(0, NeuralNetwork::InitialWeights::Random);
+        REQUIRE(network->GetInputCount() == 6);
+        RequireSameOutputs(*network);
+
+        network = network->WithColumnRemoved(0);
+        REQUIRE(network->GetInputCount() == 5);
+        RequireSameOutputs(*network);
+    }
+
+    SECTION("Mutations leave the parent unchanged")
+    {
+        auto snapshot = [](const NeuralNetwork& network)
+        {
+            std::vector<NeuralNetwork::Node> nodes;
+            network.ForEach([&](unsigned /*nodeIndex*/, unsigned /*layerIndex*/, const NeuralNetwork::Node& node)
+            {
+                nodes.push_back(node);
+            });
+            return nodes;
+        };
+
+        std::shared_ptr<NeuralNetwork> parent = std::make_shared<NeuralNetwork>(4, 6, NeuralNetwork::InitialWeights::Random);
+        parent = parent->WithRowAdded(2, NeuralNetwork::InitialWeights::PassThrough);
+        const auto before = snapshot(*parent);
+
+        for (unsigned i = 0; i < 100; ++i) {
+            std::shared_ptr<NeuralNetwork> child = parent->WithMutatedConnections();
+            RequireSameOutputs(*child);
+            child = child->WithRowAdded(Random::Number(0u, 5u), NeuralNetwork::InitialWeights::Random);
+            RequireSameOutputs(*child);
+            child = child->WithRowRemoved(Random::Number(0u, 5u));
+            RequireSameOutputs(*child);
+            child = child->WithColumnAdded(Random::Number(0u, 6u), NeuralNetwork::InitialWeights::Random);
+            RequireSameOutputs(*child);
+        }
+
+        REQUIRE(snapshot(*parent) == before);
+        REQUIRE(parent->GetElidedLayerCount() == 1);
+        RequireSameOutputs(*parent);
+    }
+
+    SECTION("Memoised evaluation")
+    {
+        NeuralNetwork network(3, 5, NeuralNetwork::InitialWeights::Random);
+        NeuralNetwork other(3, 5, NeuralNetwork::InitialWeights::Random);
+        NeuralNetwork::Memo memo;
+
+        std::vector<double> inputs = Random::Numbers(5, -1.0, 1.0);
+        std::vector<double> expected = inputs;
+        network.ForwardPropogate(expected);
+
+        for (unsigned i = 0; i < 10; ++i) {
+            std::vector<double> values = inputs;
+            network.ForwardPropogate(values, memo, 0.0);
+            REQUIRE(values == expected);
+        }
+        REQUIRE(memo.misses_ == 1);
+        REQUIRE(memo.hits_ == 9);
+
+        // Changes larger than epsilon are re-evaluated
+        std::vector<double> nudged = inputs;
+        nudged.at(2) += 0.01;
+        std::vector<double> values = nudged;
+        network.ForwardPropogate(values, memo, 0.001);
+        REQUIRE(memo.misses_ == 2);
+        std::vector<double> nudgedExpected = nudged;
+        network.ForwardPropogate(nudgedExpected);
+        REQUIRE(values == nudgedExpected);
+
+        // Changes within epsilon are not
+        values = inputs;
+        network.ForwardPropogate(values, memo, 0.1);
+        REQUIRE(memo.hits_ == 10);
+        REQUIRE(values == nudgedExpected);
+
+        // A memo is only valid for the network that filled it
+        values = nudged;
+        other.ForwardPropogate(values, memo, 0.1);
+        REQUIRE(memo.misses_ == 3);
+        std::vector<double> otherExpected = nudged;
+        other.ForwardPropogate(otherExpected);
+        REQUIRE(values == otherExpected);
+    }
+
+    SECTION("Connectivity analysis")
+    {
+        // A random network is fully connected
+        NeuralNetwork random(2, 4, NeuralNetwork::InitialWeights::Random);
+        REQUIRE(random.GetInputsAffecting({ false, true, false, false }) == std::vector<bool>(4, true));
+        REQUIRE(random.GetOutputsAffectedBy({ false, false, true, false }) == std::vector<bool>(4, true));
+        REQUIRE(random.GetInputsAffecting(std::vector<bool>(4, false)) == std::vector<bool>(4, false));
+
+        // Pass through only connects each input to the matching output
+        NeuralNetwork passThrough(3, 4, NeuralNetwork::InitialWeights::PassThrough);
+        REQUIRE(passThrough.GetInputsAffecting({ false, true, false, true }) == std::vector<bool>{ false, true, false, true });
+        REQUIRE(passThrough.GetOutputsAffectedBy({ true, false, false, false }) == std::vector<bool>{ true, false, false, false });
+
+        // Swap the first two nodes, and leave the last unconnected
+        NeuralNetwork swapped({ { { 0.0, 1.0, 0.0 }, { 0.5, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } } }, 3);
+        REQUIRE(swapped.GetInputsAffecting({ true, false, true }) == std::vector<bool>{ false, true, false });
+        REQUIRE(swapped.GetOutputsAffectedBy({ true, true, true }) == std::vector<bool>{ true, true, false });
+
+        // Inputs that can't reach an output never change it
+        std::vector<double> inputs = Random::Numbers(3, -1.0, 1.0);
+        std::vector<double> modified = inputs;
+        modified.at(2) = Random::Number(-1.0, 1.0);
+        swapped.ForwardPropogate(inputs);
+        swapped.ForwardPropogate(modified);
+        REQUIRE(inputs == modified);
+        REQUIRE(inputs.at(2) == 0.0);
+    }
+}
@@ -0,0 +1,90 @@
+#include <NeuralNetworkConnector.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+std::vector<double> ReferencePassForward(const NeuralNetworkConnector& connector, const std::vector<double>& inputs)
+{
+    std::vector<double> outputs(connector.GetOutputCount(), 0.0);
+    const auto& weights = connector.Inspect();
+    for (size_t input = 0; input < weights.size(); ++input) {
+        for (size_t output = 0; output < weights.at(input).size(); ++output) {
+            outputs.at(output) += inputs.at(input) * weights.at(input).at(output);
+        }
+    }
+    return outputs;
+}
+
+std::vector<std::vector<double>> RandomWeights(unsigned inputs, unsigned outputs, double density)
+{
+    std::vector<std::vector<double>> weights(inputs, std::vector<double>(outputs, 0.0));
+    for (auto& inputWeights : weights) {
+        for (auto& weight : inputWeights) {
+            if (Random::PercentChance(density * 100.0)) {
+                weight = Random::Number(-2.0, 2.0);
+            }
+        }
+    }
+    return weights;
+}
+
+}
+
+TEST_CASE("NeuralNetworkConnector", "[network]")
+{
+    Random::Seed(42);
+
+    SECTION("Pass through connections are sparse")
+    {
+        for (auto [ inputs, outputs ] : { std::pair{ 1u, 1u }, std::pair{ 3u, 7u }, std::pair{ 7u, 3u }, std::pair{ 7u, 7u } }) {
+            NeuralNetworkConnector connector(inputs, outputs);
+            REQUIRE(connector.GetConnectionCount() == std::min(inputs, outputs));
+            REQUIRE(connector.IsSparse() == (std::min(inputs, outputs) <= inputs * outputs * 0.5));
+        }
+    }
+
+    SECTION("Sparse and dense representations agree")
+    {
+        for (double density : { 0.0, 0.05, 0.25, 0.5, 0.75, 1.0 }) {
+            for (unsigned i = 0; i < 20; ++i) {
+                unsigned inputCount = Random::Number(1u, 12u);
+                unsigned outputCount = Random::Number(1u, 12u);
+                NeuralNetworkConnector connector(RandomWeights(inputCount, outputCount, density));
+
+                std::vector<double> inputs = Random::Numbers(inputCount, -1.0, 1.0);
+                std::vector<double> outputs(outputCount, 0.0);
+                connector.PassForward(inputs, outputs);
+
+                std::vector<double> expected = ReferencePassForward(connector, inputs);
+                for (size_t output = 0; output < outputCount; ++output) {
+                    REQUIRE_THAT(outputs.at(output), Catch::Matchers::WithinAbs(expected.at(output), 0.000001));
+                }
+            }
+        }
+    }
+
+    SECTION("Mutations update the representation")
+    {
+        std::shared_ptr<NeuralNetworkConnector> connector = std::make_shared<NeuralNetworkConnector>(7, 7);
+        for (unsigned i = 0; i < 500; ++i) {
+            connector = connector->WithMutatedConnections();
+
+            unsigned nonZero = 0;
+            for (const auto& inputWeights : connector->Inspect()) {
+                nonZero += std::count_if(std::cbegin(inputWeights), std::cend(inputWeights), [](double weight) { return weight != 0.0; });
+            }
+            REQUIRE(connector->GetConnectionCount() == nonZero);
+            REQUIRE(connector->IsSparse() == (nonZero <= 7 * 7 * 0.5));
+
+            std::vector<double> inputs = Random::Numbers(7, -1.0, 1.0);
+            std::vector<double> outputs(7, 0.0);
+            connector->PassForward(inputs, outputs);
+            std::vector<double> expected = ReferencePassForward(*connector, inputs);
+            for (size_t output = 0; output < 7; ++output) {
+                REQUIRE_THAT(outputs.at(output), Catch::Matchers::WithinAbs(expected.at(output), 0.000001));
+            }
+        }
+    }
+}
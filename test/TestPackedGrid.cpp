@@ -0,0 +1,151 @@
+#include <PackedGrid.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+#include <set>
+
+using namespace Tril;
+
+namespace {
+
+class TestType {
+public:
+    Point location_;
+
+    TestType(const Point& location)
+        : location_(location)
+    {
+    }
+
+    const Point& GetLocation() const
+    {
+        return location_;
+    }
+};
+
+struct TestAggregate {
+    unsigned count = 0;
+
+    void Add(const TestType&)
+    {
+        ++count;
+    }
+};
+
+std::set<const TestType*> ItemsIn(const PackedGrid<TestType, TestAggregate>& grid, const Rect& area)
+{
+    std::set<const TestType*> found;
+    grid.ForEachItem(area, [&](const std::shared_ptr<TestType>& item)
+    {
+        REQUIRE(found.insert(item.get()).second);
+    });
+    return found;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("PackedGrid", "[container]")
+{
+    Random::Seed(42);
+
+    const Rect area{ -100, -100, 100, 100 };
+    PackedGrid<TestType, TestAggregate> grid(10.0);
+    std::vector<std::shared_ptr<TestType>> items;
+    for (unsigned i = 0; i < 500; ++i) {
+        items.push_back(std::make_shared<TestType>(Random::PointIn(area)));
+        grid.Insert(items.back());
+    }
+
+    SECTION("Items are only found once packed")
+    {
+        REQUIRE(grid.Size() == items.size());
+        REQUIRE(ItemsIn(grid, area).empty());
+        grid.Update();
+        REQUIRE(grid.Size() == items.size());
+        REQUIRE(ItemsIn(grid, area).size() == items.size());
+    }
+
+    SECTION("Finds every item within an area")
+    {
+        grid.Update();
+        for (unsigned repeat = 0; repeat < 100; ++repeat) {
+            Point a = Random::PointIn(area);
+            Point b = Random::PointIn(area);
+            Rect search{ std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y) };
+            std::set<const TestType*> found = ItemsIn(grid, search);
+            for (const auto& item : items) {
+                if (Contains(search, item->GetLocation())) {
+                    REQUIRE(found.count(item.get()) == 1);
+                }
+            }
+        }
+        REQUIRE(ItemsIn(grid, { 200, 200, 300, 300 }).empty());
+        REQUIRE(ItemsIn(grid, { -300, -300, -200, -200 }).empty());
+    }
+
+    SECTION("Remove")
+    {
+        grid.Update();
+        grid.RemoveIf([](const TestType& item)
+        {
+            return item.GetLocation().x < 0.0;
+        });
+        std::set<const TestType*> found = ItemsIn(grid, area);
+        REQUIRE(grid.Size() == found.size());
+        for (const auto& item : items) {
+            REQUIRE(found.count(item.get()) == (item->GetLocation().x < 0.0 ? 0 : 1));
+        }
+
+        for (const auto& item : items) {
+            REQUIRE(grid.Includes(*item) == (item->GetLocation().x >= 0.0));
+        }
+
+        grid.Clear();
+        REQUIRE(grid.Size() == 0);
+        REQUIRE(ItemsIn(grid, area).empty());
+    }
+
+    SECTION("Aggregates")
+    {
+        grid.Update();
+        REQUIRE(!grid.AggregatesValid());
+        grid.UpdateAggregates();
+        REQUIRE(grid.AggregatesValid());
+
+        const Circle search{ 0, 0, 50 };
+        unsigned total = 0;
+        unsigned aggregates = 0;
+        grid.ForEachAggregateOrItem(search, [&](const Rect& cellArea, const TestAggregate& aggregate)
+        {
+            REQUIRE(Contains(search, cellArea));
+            ++aggregates;
+            total += aggregate.count;
+        }, [&](const TestType& item)
+        {
+            if (Collides(search, item.GetLocation())) {
+                ++total;
+            }
+        });
+        REQUIRE(aggregates > 0);
+        REQUIRE(total == std::count_if(std::cbegin(items), std::cend(items), [&](const auto& item)
+        {
+            return Collides(search, item->GetLocation());
+        }));
+
+        // Cells with no items can be skipped
+        unsigned visited = 0;
+        grid.ForEachItem(area, [&](const std::shared_ptr<TestType>&)
+        {
+            ++visited;
+        }, [](const TestAggregate& aggregate)
+        {
+            return aggregate.count == 0;
+        });
+        REQUIRE(visited == 0);
+
+        grid.Insert(std::make_shared<TestType>(Point{ 0, 0 }));
+        grid.Update();
+        REQUIRE(!grid.AggregatesValid());
+    }
+}
@@ -3,6 +3,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <limits>
+
 using namespace Tril;
 
 namespace {
@@ -29,6 +31,26 @@ public:
     }
 };
 
+struct TestAggregate {
+    unsigned count = 0;
+    double xSum = 0.0;
+    double minX = std::numeric_limits<double>::max();
+
+    void Add(const TestType& item)
+    {
+        ++count;
+        xSum += item.GetLocation().x;
+        minX = std::min(minX, item.GetLocation().x);
+    }
+
+    void Add(const TestAggregate& other)
+    {
+        count += other.count;
+        xSum += other.xSum;
+        minX = std::min(minX, other.minX);
+    }
+};
+
 inline auto PointComparator = [](const Point& a, const Point& b)
 {
     return a.x < b.x || (a.x == b.x && a.y < b.y);
@@ -401,6 +423,35 @@ TEST_CASE("QuadTree", "[container]")
         }
     }
 
+    SECTION("Moving items, then updating")
+    {
+        const Rect area{ 0, 0, 10, 10 };
+        const double minQuadSize = 1.0;
+        const size_t itemCount = 50;
+        const size_t targetCount = 5;
+        const size_t countLeeway = 0;
+        QuadTree<TestType> tree(area, targetCount, countLeeway, minQuadSize);
+
+        std::vector<std::shared_ptr<TestType>> items;
+        for (size_t i = 0; i < itemCount; ++i) {
+            items.push_back(std::make_shared<TestType>(Random::PointIn(area)));
+        }
+        tree.Insert(items);
+        REQUIRE(tree.Validate());
+        REQUIRE(tree.Size() == itemCount);
+
+        for (auto& item : items) {
+            item->location_ = Random::PointIn(area);
+        }
+        tree.Update([&](const TestType& item)
+        {
+            return &item == items.front().get();
+        });
+
+        REQUIRE(tree.Validate());
+        REQUIRE(tree.Size() == itemCount - 1);
+    }
+
     SECTION("Full use-case test")
     {
         const Rect startArea{ 0, 0, 10, 10 };
@@ -498,4 +549,170 @@ TEST_CASE("QuadTree", "[container]")
             REQUIRE(tree.Validate());
         }));
     }
+
+    SECTION("Aggregates")
+    {
+        const Rect area{ 0, 0, 100, 100 };
+        const size_t countLeeway = 2;
+        const double minQuadSize = 1.0;
+        const size_t itemCount = 500;
+        QuadTree<TestType, TestAggregate> tree(area, 5, countLeeway, minQuadSize);
+
+        for (size_t i = 0; i < itemCount; ++i) {
+            tree.Insert(std::make_shared<TestType>(Random::PointIn(area)));
+        }
+        REQUIRE(!tree.AggregatesValid());
+
+        auto totalWithin = [&](const Circle& circle, unsigned& aggregateCount)
+        {
+            TestAggregate total;
+            tree.ForEachAggregateOrItem(circle, [&](const Rect& quadArea, const TestAggregate& aggregate)
+            {
+                REQUIRE(Contains(circle, quadArea));
+                ++aggregateCount;
+                total.Add(aggregate);
+            }, [&](const TestType& item)
+            {
+                if (Contains(circle, item.GetLocation())) {
+                    total.Add(item);
+                }
+            });
+            return total;
+        };
+
+        auto expectedWithin = [&](const Circle& circle)
+        {
+            TestAggregate expected;
+            tree.ForEachItem(ConstQuadTreeIterator<TestType>([&](const TestType& item)
+            {
+                if (Contains(circle, item.GetLocation())) {
+                    expected.Add(item);
+                }
+            }));
+            return expected;
+        };
+
+        // Without valid aggregates, every item is visited
+        unsigned aggregateCount = 0;
+        Circle everything{ 50, 50, 1000 };
+        REQUIRE(totalWithin(everything, aggregateCount).count == itemCount);
+        REQUIRE(aggregateCount == 0);
+
+        tree.UpdateAggregates();
+        REQUIRE(tree.AggregatesValid());
+        REQUIRE(totalWithin(everything, aggregateCount).count == itemCount);
+        REQUIRE(aggregateCount == 1);
+
+        aggregateCount = 0;
+        for (int i = 0; i < 100; ++i) {
+            Circle circle{ Random::Number(0.0, 100.0), Random::Number(0.0, 100.0), Random::Number(1.0, 60.0) };
+            TestAggregate total = totalWithin(circle, aggregateCount);
+            TestAggregate expected = expectedWithin(circle);
+            REQUIRE(total.count == expected.count);
+            REQUIRE_THAT(total.xSum, Catch::Matchers::WithinAbs(expected.xSum, 0.000001));
+        }
+        REQUIRE(aggregateCount > 0);
+
+        // Any change to the shape of the tree invalidates the aggregates
+        tree.Insert(std::make_shared<TestType>(Random::PointIn(area)));
+        REQUIRE(!tree.AggregatesValid());
+        aggregateCount = 0;
+        REQUIRE(totalWithin(everything, aggregateCount).count == itemCount + 1);
+        REQUIRE(aggregateCount == 0);
+
+        tree.UpdateAggregates();
+        tree.ForEachItem(QuadTreeIterator<TestType>([](std::shared_ptr<TestType> item)
+        {
+            item->location_ = Random::PointIn(Rect{ 0, 0, 100, 100 });
+        }));
+        REQUIRE(!tree.AggregatesValid());
+        REQUIRE(tree.Validate());
+    }
+
+    SECTION("Aggregate filters")
+    {
+        const Rect area{ 0, 0, 100, 100 };
+        const size_t itemCount = 500;
+        QuadTree<TestType, TestAggregate> tree(area, 5, 2, 1.0);
+
+        for (size_t i = 0; i < itemCount; ++i) {
+            tree.Insert(std::make_shared<TestType>(Random::PointIn(area)));
+        }
+
+        auto hasItemsLeftOf25 = [](const TestAggregate& aggregate)
+        {
+            return aggregate.minX < 25.0;
+        };
+        auto countVisited = [&](unsigned& leftOf25)
+        {
+            unsigned visited = 0;
+            leftOf25 = 0;
+            tree.ForEachItem(ConstQuadTreeIterator<TestType>([&](const TestType& item)
+            {
+                ++visited;
+                if (item.GetLocation().x < 25.0) {
+                    ++leftOf25;
+                }
+            }), hasItemsLeftOf25);
+            return visited;
+        };
+
+        // Without valid aggregates no quads are skipped
+        unsigned leftOf25 = 0;
+        REQUIRE(countVisited(leftOf25) == itemCount);
+        const unsigned expectedLeftOf25 = leftOf25;
+
+        tree.UpdateAggregates();
+        unsigned visited = countVisited(leftOf25);
+        REQUIRE(leftOf25 == expectedLeftOf25);
+        REQUIRE(visited < itemCount);
+    }
+
+    SECTION("Tiles")
+    {
+        const Rect area{ 0, 0, 100, 100 };
+        const size_t itemCount = 500;
+        QuadTree<TestType> tree(area, 5, 2, 1.0);
+
+        auto collectTiles = [&](size_t depth, std::vector<Rect>& tiles)
+        {
+            tiles.clear();
+            std::vector<std::shared_ptr<TestType>> items;
+            tree.ForEachTile(depth, [&](const Rect& tileArea)
+            {
+                tiles.push_back(tileArea);
+            }, [&](const std::shared_ptr<TestType>& item)
+            {
+                REQUIRE(!tiles.empty());
+                REQUIRE(Contains(tiles.back(), item->GetLocation()));
+                items.push_back(item);
+            });
+            return items.size();
+        };
+
+        // A leaf root is a single tile, no matter the depth
+        std::vector<Rect> tiles;
+        REQUIRE(collectTiles(2, tiles) == 0);
+        REQUIRE(tiles.size() == 1);
+
+        for (size_t i = 0; i < itemCount; ++i) {
+            tree.Insert(std::make_shared<TestType>(Random::PointIn(area)));
+        }
+
+        REQUIRE(collectTiles(0, tiles) == itemCount);
+        REQUIRE(tiles.size() == 1);
+        REQUIRE(collectTiles(1, tiles) == itemCount);
+        REQUIRE(tiles.size() == 4);
+        REQUIRE(collectTiles(2, tiles) == itemCount);
+        REQUIRE(tiles.size() == 16);
+
+        // Items that move only change tile once the tree is updated
+        tree.ForEachItemNoRebalance(QuadTreeIterator<TestType>([](std::shared_ptr<TestType> item)
+        {
+            item->location_ = Random::PointIn(Rect{ 0, 0, 100, 100 });
+        }));
+        tree.Update([](const TestType&) { return false; });
+        REQUIRE(collectTiles(2, tiles) == itemCount);
+        REQUIRE(tree.Validate());
+    }
 }
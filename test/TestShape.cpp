@@ -1,4 +1,5 @@
 #include <Shape.h>
+#include <Transform.h>
 #include <Random.h>
 
 #include <catch2/catch.hpp>
@@ -299,3 +300,23 @@ TEST_CASE("Collision", "[shape]")
         }
     }
 }
+
+TEST_CASE("Heading", "[shape]")
+{
+    Random::Seed(42);
+
+    SECTION("LocalOffset matches ApplyOffset")
+    {
+        for (unsigned i = 0; i < 1000; ++i) {
+            Point origin = { Random::Number(-1000.0, 1000.0), Random::Number(-1000.0, 1000.0) };
+            double headingBearing = Random::Number(-Tril::Tau, Tril::Tau);
+            double offsetBearing = Random::Number(-Tril::Tau, Tril::Tau);
+            double distance = Random::Number(0.0, 100.0);
+
+            Point expected = ApplyOffset(origin, headingBearing + offsetBearing, distance);
+            Point actual = LocalOffset::FromPolar(offsetBearing, distance).ApplyTo(origin, Heading::FromBearing(headingBearing));
+            REQUIRE_THAT(actual.x, Catch::Matchers::WithinAbs(expected.x, 0.000001));
+            REQUIRE_THAT(actual.y, Catch::Matchers::WithinAbs(expected.y, 0.000001));
+        }
+    }
+}
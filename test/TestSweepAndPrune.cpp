@@ -0,0 +1,79 @@
+#include <SweepAndPrune.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+#include <set>
+
+using namespace Tril;
+
+namespace {
+
+std::set<std::pair<size_t, size_t>> OverlappingPairs(const SweepAndPrune& sweep)
+{
+    std::set<std::pair<size_t, size_t>> pairs;
+    for (size_t index = 0; index < sweep.Size(); ++index) {
+        sweep.ForEachOverlapping(index, [&](size_t other)
+        {
+            REQUIRE(other != index);
+            pairs.insert({ index, other });
+        });
+    }
+    return pairs;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("SweepAndPrune", "[container]")
+{
+    Random::Seed(42);
+
+    SweepAndPrune sweep;
+    sweep.Clear();
+
+    SECTION("Empty")
+    {
+        sweep.Update();
+        REQUIRE(sweep.Size() == 0);
+        REQUIRE(sweep.PairCount() == 0);
+    }
+
+    SECTION("Touching circles overlap")
+    {
+        sweep.Add({ 0.0, 0.0, 1.0 });
+        sweep.Add({ 2.0, 0.0, 1.0 });
+        sweep.Add({ 0.0, 2.0, 1.0 });
+        sweep.Add({ 2.5, 2.5, 0.1 });
+        sweep.Update();
+        REQUIRE(sweep.PairCount() == 2);
+        REQUIRE(OverlappingPairs(sweep) == std::set<std::pair<size_t, size_t>>{ { 0, 1 }, { 1, 0 }, { 0, 2 }, { 2, 0 } });
+    }
+
+    SECTION("Matches brute force")
+    {
+        for (unsigned repeat = 0; repeat < 10; ++repeat) {
+            std::vector<Circle> circles;
+            for (unsigned i = 0; i < 500; ++i) {
+                circles.push_back({ Random::Number(-200.0, 200.0), Random::Number(-200.0, 200.0), Random::Number(0.5, 12.0) });
+            }
+
+            sweep.Clear();
+            for (const Circle& circle : circles) {
+                sweep.Add(circle);
+            }
+            sweep.Update();
+            REQUIRE(sweep.Size() == circles.size());
+
+            std::set<std::pair<size_t, size_t>> expected;
+            for (size_t a = 0; a < circles.size(); ++a) {
+                for (size_t b = 0; b < circles.size(); ++b) {
+                    if (a != b && Collides(circles.at(a), circles.at(b))) {
+                        expected.insert({ a, b });
+                    }
+                }
+            }
+            REQUIRE(OverlappingPairs(sweep) == expected);
+            REQUIRE(sweep.PairCount() * 2 == expected.size());
+        }
+    }
+}
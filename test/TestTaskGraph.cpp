@@ -0,0 +1,135 @@
+#include <TaskGraph.h>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Tril;
+
+// Catch's assertions aren't thread safe, so tasks only record their results
+TEST_CASE("TaskGraph", "[threading]")
+{
+    const size_t threadCount = GENERATE(as<size_t>{}, 1, 2, 4);
+    ThreadPool pool(threadCount);
+    TaskGraph graph;
+
+    SECTION("Empty")
+    {
+        graph.Run(pool);
+        REQUIRE(graph.Size() == 0);
+    }
+
+    SECTION("Tasks start once their dependencies have finished")
+    {
+        std::atomic<int> step = 0;
+        std::vector<int> started(8, -1);
+        std::vector<int> finished(8, -1);
+        auto record = [&](TaskGraph::TaskId id)
+        {
+            return [&, id]()
+            {
+                started[id] = step++;
+                std::this_thread::yield();
+                finished[id] = step++;
+            };
+        };
+
+        /*
+         *    0   1
+         *   / \ /
+         *  2   3   4
+         *   \ / \ /
+         *    5   6
+         *     \ /
+         *      7
+         */
+        std::vector<std::vector<TaskGraph::TaskId>> dependencies{ {}, {}, { 0 }, { 0, 1 }, {}, { 2, 3 }, { 3, 4 }, { 5, 6 } };
+        for (TaskGraph::TaskId id = 0; id < dependencies.size(); ++id) {
+            REQUIRE(graph.Add("Task " + std::to_string(id), record(id), dependencies[id]) == id);
+        }
+        REQUIRE(graph.Size() == 8);
+        REQUIRE(graph.GetName(5) == "Task 5");
+
+        for (int run = 0; run < 3; ++run) {
+            step = 0;
+            graph.Run(pool);
+            for (TaskGraph::TaskId id = 0; id < dependencies.size(); ++id) {
+                REQUIRE(started[id] >= 0);
+                REQUIRE(finished[id] > started[id]);
+                for (TaskGraph::TaskId dependency : dependencies[id]) {
+                    REQUIRE(finished[dependency] < started[id]);
+                }
+            }
+            REQUIRE(step == 16);
+        }
+    }
+
+    SECTION("Independent tasks run at the same time")
+    {
+        if (threadCount > 1) {
+            // Each task waits for the other to start, which can only happen if both run at once
+            std::atomic<int> running = 0;
+            std::atomic<bool> timedOut = false;
+            auto waitForOther = [&]()
+            {
+                ++running;
+                auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while (running < 2 && !timedOut) {
+                    timedOut = std::chrono::steady_clock::now() > giveUp;
+                    std::this_thread::yield();
+                }
+            };
+            graph.Add("A", waitForOther);
+            graph.Add("B", waitForOther);
+            graph.Run(pool);
+            REQUIRE(!timedOut);
+        }
+    }
+
+    SECTION("Durations")
+    {
+        auto first = graph.Add("Sleep", []()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        });
+        auto second = graph.Add("Nothing", []()
+        {
+        }, { first });
+        graph.Run(pool);
+        REQUIRE(graph.GetDuration(first) >= std::chrono::milliseconds(20));
+        REQUIRE(graph.GetDuration(second) < std::chrono::milliseconds(20));
+    }
+
+    SECTION("Exceptions")
+    {
+        std::atomic<bool> dependentRun = false;
+        std::atomic<bool> independentRun = false;
+        auto failing = graph.Add("Failing", []()
+        {
+            throw std::runtime_error("Task failed");
+        });
+        graph.Add("Dependent", [&]()
+        {
+            dependentRun = true;
+        }, { failing });
+        auto independent = graph.Add("Independent", [&]()
+        {
+            independentRun = true;
+        });
+
+        REQUIRE_THROWS_AS(graph.Run(pool), std::runtime_error);
+        REQUIRE(!dependentRun);
+        REQUIRE(independentRun);
+        REQUIRE(graph.GetDuration(failing) == std::chrono::steady_clock::duration::zero());
+
+        // Adding a task after running resets the graph for the next run
+        graph.Add("Later", []()
+        {
+        }, { independent });
+        REQUIRE_THROWS_AS(graph.Run(pool), std::runtime_error);
+        REQUIRE(!dependentRun);
+    }
+}
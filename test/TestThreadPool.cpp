@@ -0,0 +1,231 @@
+#include <ThreadPool.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cmath>
+
+using namespace Tril;
+
+namespace {
+
+// Deliberately slow, so that the work outweighs the cost of scheduling it
+double Work(size_t index)
+{
+    double total = 0.0;
+    for (size_t i = 0; i < 200; ++i) {
+        total += std::sqrt(static_cast<double>(index + i));
+    }
+    return total;
+}
+
+} // end anonymous namespace
+
+// Catch's assertions aren't thread safe, so tasks only record their results
+TEST_CASE("ThreadPool", "[threading]")
+{
+    const size_t threadCount = GENERATE(as<size_t>{}, 1, 2, 4, 7);
+    ThreadPool pool(threadCount);
+    REQUIRE(pool.GetThreadCount() == threadCount);
+    REQUIRE(pool.GetThreadIndex() == 0);
+
+    SECTION("ParallelFor visits every index exactly once")
+    {
+        for (size_t count : { 0, 1, 5, 1000, 12345 }) {
+            for (size_t grainSize : { 0, 1, 16, 100000 }) {
+                std::vector<std::atomic<int>> visits(count);
+                std::atomic<bool> chunksValid = true;
+                pool.ParallelFor(0, count, grainSize, [&](size_t begin, size_t end)
+                {
+                    if (begin >= end || (end - begin < grainSize && end != count)) {
+                        chunksValid = false;
+                    }
+                    for (size_t i = begin; i < end; ++i) {
+                        ++visits[i];
+                    }
+                });
+                REQUIRE(chunksValid);
+                for (const auto& visitCount : visits) {
+                    REQUIRE(visitCount == 1);
+                }
+            }
+        }
+    }
+
+    SECTION("ParallelFor over an offset range")
+    {
+        std::atomic<size_t> total = 0;
+        std::atomic<bool> chunksValid = true;
+        pool.ParallelFor(100, 200, 1, [&](size_t begin, size_t end)
+        {
+            if (begin < 100 || end > 200) {
+                chunksValid = false;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                total += i;
+            }
+        });
+        REQUIRE(chunksValid);
+        REQUIRE(total == 14950);
+    }
+
+    SECTION("Nested ParallelFor")
+    {
+        std::atomic<size_t> total = 0;
+        pool.ParallelFor(0, 50, 1, [&](size_t outerBegin, size_t outerEnd)
+        {
+            for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+                pool.ParallelFor(0, 50, 1, [&](size_t begin, size_t end)
+                {
+                    total += end - begin;
+                });
+            }
+        });
+        REQUIRE(total == 2500);
+    }
+
+    SECTION("TaskGroup")
+    {
+        std::atomic<int> tasksRun = 0;
+        TaskGroup group(pool);
+        for (int i = 0; i < 100; ++i) {
+            group.Run([&]()
+            {
+                ++tasksRun;
+                // Tasks can add more tasks to their own group
+                group.Run([&]()
+                {
+                    ++tasksRun;
+                });
+            });
+        }
+        group.Wait();
+        REQUIRE(tasksRun == 200);
+
+        // Can be reused once waited on
+        group.Run([&]()
+        {
+            ++tasksRun;
+        });
+        group.Wait();
+        REQUIRE(tasksRun == 201);
+    }
+
+    SECTION("TaskGroup rethrows exceptions")
+    {
+        std::atomic<int> tasksRun = 0;
+        TaskGroup group(pool);
+        for (int i = 0; i < 10; ++i) {
+            group.Run([&, i]()
+            {
+                ++tasksRun;
+                if (i == 3) {
+                    throw std::runtime_error("Task failed");
+                }
+            });
+        }
+        REQUIRE_THROWS_AS(group.Wait(), std::runtime_error);
+        REQUIRE(tasksRun == 10);
+
+        // Only rethrown once
+        group.Wait();
+    }
+
+    SECTION("PerThread")
+    {
+        PerThread<std::vector<size_t>> visited(pool);
+        PerThread<size_t> totals(pool, 0);
+        std::atomic<size_t> maxIndex = 0;
+        pool.ParallelFor(0, 10000, 1, [&](size_t begin, size_t end)
+        {
+            size_t index = pool.GetThreadIndex();
+            size_t previous = maxIndex;
+            while (index > previous && !maxIndex.compare_exchange_weak(previous, index)) {
+            }
+            for (size_t i = begin; i < end; ++i) {
+                visited.Local().push_back(i);
+                totals.Local() += i;
+            }
+        });
+
+        std::vector<size_t> allVisited;
+        visited.ForEach([&](const std::vector<size_t>& indices)
+        {
+            allVisited.insert(std::end(allVisited), std::begin(indices), std::end(indices));
+        });
+        std::sort(std::begin(allVisited), std::end(allVisited));
+        REQUIRE(allVisited.size() == 10000);
+        for (size_t i = 0; i < allVisited.size(); ++i) {
+            REQUIRE(allVisited[i] == i);
+        }
+
+        size_t total = 0;
+        totals.ForEach([&](size_t threadTotal)
+        {
+            total += threadTotal;
+        });
+        REQUIRE(total == 49995000);
+        REQUIRE(maxIndex < threadCount);
+    }
+
+    SECTION("Random streams draw the same numbers on any thread")
+    {
+        auto draw = [](size_t i)
+        {
+            Random::Stream random(42u, i);
+            return Random::Number(0.0, 1.0);
+        };
+        Random::Seed(42);
+        std::vector<double> expected;
+        for (size_t i = 0; i < 1000; ++i) {
+            expected.push_back(draw(i));
+        }
+
+        std::vector<double> drawn(expected.size());
+        pool.ParallelFor(0, drawn.size(), 1, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) {
+                drawn[i] = draw(i);
+            }
+        });
+        REQUIRE(drawn == expected);
+        REQUIRE(std::adjacent_find(std::begin(expected), std::end(expected)) == std::end(expected));
+    }
+}
+
+// Hidden by default, run with: Tests "[benchmark]"
+TEST_CASE("ThreadPool scaling", "[.][benchmark]")
+{
+    const size_t count = 1'000'000;
+    std::vector<double> expected(count);
+    for (size_t i = 0; i < count; ++i) {
+        expected[i] = Work(i);
+    }
+
+    double singleThreadedSeconds = 0.0;
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        ThreadPool pool(threadCount);
+        std::vector<double> results(count);
+
+        auto begin = std::chrono::steady_clock::now();
+        pool.ParallelFor(0, count, 1024, [&](size_t chunkBegin, size_t chunkEnd)
+        {
+            for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                results[i] = Work(i);
+            }
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        REQUIRE(results == expected);
+        if (threadCount == 1) {
+            singleThreadedSeconds = seconds;
+        }
+        std::cout << threadCount << " threads: " << seconds * 1000.0 << "ms, " << singleThreadedSeconds / seconds << "x speedup" << std::endl;
+    }
+}
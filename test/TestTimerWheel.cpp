@@ -0,0 +1,89 @@
+#include <TimerWheel.h>
+#include <Random.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+
+using namespace Tril;
+
+TEST_CASE("TimerWheel", "[container]")
+{
+    Random::Seed(42);
+
+    TimerWheel<unsigned> wheel;
+    REQUIRE(wheel.Size() == 0);
+    REQUIRE(wheel.Now() == 0);
+
+    SECTION("Fires on the scheduled tick")
+    {
+        wheel.Schedule(0, 0);
+        wheel.Schedule(1, 1);
+        wheel.Schedule(255, 255);
+        wheel.Schedule(256, 256);
+        wheel.Schedule(70000, 70000);
+        REQUIRE(wheel.Size() == 5);
+
+        for (uint64_t tick = 0; tick <= 70000; ++tick) {
+            wheel.Advance(tick, [&](unsigned item)
+            {
+                REQUIRE(item == tick);
+            });
+        }
+        REQUIRE(wheel.Size() == 0);
+        REQUIRE(wheel.Now() == 70001);
+    }
+
+    SECTION("Late items fire at the next advance")
+    {
+        wheel.Advance(10, [](unsigned) { FAIL(); });
+        wheel.Schedule(5, 5);
+        unsigned fired = 0;
+        wheel.Advance(11, [&](unsigned item)
+        {
+            REQUIRE(item == 5);
+            ++fired;
+        });
+        REQUIRE(fired == 1);
+    }
+
+    SECTION("Items can be scheduled while advancing")
+    {
+        std::vector<uint64_t> fired;
+        wheel.Schedule(3, 3);
+        wheel.Advance(1000, [&](unsigned item)
+        {
+            fired.push_back(wheel.Now());
+            if (item < 500) {
+                wheel.Schedule(item * 2, item * 2);
+            }
+        });
+        REQUIRE(fired == std::vector<uint64_t>{ 3, 6, 12, 24, 48, 96, 192, 384, 768 });
+    }
+
+    SECTION("Matches brute force")
+    {
+        std::multimap<uint64_t, unsigned> expected;
+        for (unsigned i = 0; i < 5000; ++i) {
+            uint64_t tick = Random::Number<uint64_t>(0, 1'000'000);
+            wheel.Schedule(tick, i);
+            expected.insert({ tick, i });
+        }
+        REQUIRE(wheel.Size() == expected.size());
+
+        uint64_t previous = 0;
+        for (uint64_t tick = 0; tick <= 1'000'000; tick += Random::Number<uint64_t>(1, 5000)) {
+            wheel.Advance(tick, [&](unsigned item)
+            {
+                auto [ first, last ] = expected.equal_range(wheel.Now());
+                auto iter = std::find_if(first, last, [&](const auto& entry) { return entry.second == item; });
+                REQUIRE(iter != last);
+                REQUIRE(iter->first >= previous);
+                REQUIRE(iter->first <= tick);
+                expected.erase(iter);
+            });
+            previous = tick;
+            REQUIRE(wheel.Size() == expected.size());
+        }
+    }
+}